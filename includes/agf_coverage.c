@@ -0,0 +1,76 @@
+/*------------------------------------------------------------------------*/
+/* Coverage runtime for tools tested with AIGoFuzzing.
+ *
+ * Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+ * Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+ *
+ * Compile the tool under test with SanitizerCoverage, i.e. with
+ * '-fsanitize-coverage=trace-pc-guard' (clang) or
+ * '-fsanitize-coverage=trace-pc' (gcc), and link it against this file,
+ * which itself has to be compiled WITHOUT coverage instrumentation.  The
+ * hit counts of the executed edges are written to the AFL style bitmap in
+ * the shared memory segment given in the environment variable
+ * '__AFL_SHM_ID', which is set by AIGoFuzzing for a coverage-guided
+ * campaign ('--campaign') and for corpus minimization ('--cmin').  Without
+ * this variable the counts go to a private dummy map.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/shm.h>
+
+#define AGF_MAP_SIZE (1 << 16)
+
+static unsigned char agf_dummy_map[AGF_MAP_SIZE];
+static unsigned char *agf_area = agf_dummy_map;
+static uintptr_t agf_prev_loc;
+
+__attribute__ ((constructor)) static void
+agf_coverage_init (void)
+{
+  const char *id = getenv ("__AFL_SHM_ID");
+  void *map;
+
+  if (!id)
+    return;
+
+  map = shmat (atoi (id), 0, 0);
+  if (map == (void *) -1)
+    return;
+
+  agf_area = map;
+}
+
+/* clang: one guard per edge, numbered consecutively at start up.
+ */
+void
+__sanitizer_cov_trace_pc_guard_init (uint32_t * start, uint32_t * stop)
+{
+  static uint32_t n;
+  uint32_t *guard;
+
+  if (start == stop || *start)
+    return;
+
+  for (guard = start; guard < stop; guard++)
+    *guard = ++n % AGF_MAP_SIZE;
+}
+
+void
+__sanitizer_cov_trace_pc_guard (uint32_t * guard)
+{
+  agf_area[*guard]++;
+}
+
+/* gcc: one call per basic block, edges are hashed from the return
+ * addresses of the previous and the current block as in AFL.  Addresses
+ * are taken relative to this file to be independent of ASLR.
+ */
+void
+__sanitizer_cov_trace_pc (void)
+{
+  uintptr_t cur = (uintptr_t) __builtin_return_address (0);
+  cur -= (uintptr_t) agf_coverage_init;
+  cur = ((cur >> 4) ^ (cur << 8)) & (AGF_MAP_SIZE - 1);
+  agf_area[cur ^ agf_prev_loc]++;
+  agf_prev_loc = cur >> 1;
+}
@@ -0,0 +1,62 @@
+/*------------------------------------------------------------------------*/
+/* Fork server hook for tools tested with AIGoFuzzing.
+ *
+ * Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+ * Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+ *
+ * Call 'agf_forkserver ()' in the tool under test after all work that does
+ * not depend on the input, e.g. at the start of 'main', and before the
+ * input AIG is opened.  If the tool is not started by AIGoFuzzing with
+ * '--forkserver' the function returns immediately.  Otherwise the tool
+ * stops at the hook and forks a fresh copy of itself for each mutant,
+ * which returns from the hook and runs as usual.  The protocol over the
+ * inherited file descriptors 198 and 199 is the one of the classic AFL
+ * fork server, thus AFL instrumented tools can be used as well.
+ */
+#ifndef agf_forkserver_h_INCLUDED
+#define agf_forkserver_h_INCLUDED
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define AGF_FORKSRV_FD 198
+
+static void
+agf_forkserver (void)
+{
+  int status, request;
+  pid_t child;
+
+  status = 0;
+  if (write (AGF_FORKSRV_FD + 1, &status, 4) != 4)
+    return;
+
+  for (;;)
+    {
+      if (read (AGF_FORKSRV_FD, &request, 4) != 4)
+	_exit (1);
+
+      child = fork ();
+      if (child < 0)
+	_exit (1);
+
+      if (!child)
+	{
+	  close (AGF_FORKSRV_FD);
+	  close (AGF_FORKSRV_FD + 1);
+	  return;
+	}
+
+      if (write (AGF_FORKSRV_FD + 1, &child, 4) != 4)
+	_exit (1);
+
+      if (waitpid (child, &status, 0) < 0)
+	_exit (1);
+
+      if (write (AGF_FORKSRV_FD + 1, &status, 4) != 4)
+	_exit (1);
+    }
+}
+
+#endif
@@ -0,0 +1,221 @@
+/*------------------------------------------------------------------------*/
+/* Shared-memory ring buffer of mutants written by AIGoFuzzing '--shm'.
+ *
+ * Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+ * Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+ *
+ * AIGoFuzzing started with '--shm <name>' creates the POSIX shared memory
+ * object '/<name>' and writes the serialized mutants into a ring buffer in
+ * it.  A harness on the same host reads them in place, without copying
+ * them through the kernel:
+ *
+ *   agf_ring_reader reader;
+ *   const unsigned char *data;
+ *   size_t bytes;
+ *   unsigned seed;
+ *
+ *   if (agf_ring_open (&reader, "agf-ring"))
+ *     exit (1);
+ *   while ((data = agf_ring_next (&reader, &bytes, &seed)))
+ *     {
+ *       check (data, bytes);           // e.g. 'aiger_read_generic'
+ *       agf_ring_release (&reader);    // 'data' is reused afterwards
+ *     }
+ *   agf_ring_close (&reader);
+ *
+ * The ring has a single writer and a single reader.  A mutant is a record
+ * of a 16 byte header and its bytes, padded to 16 bytes, stored
+ * contiguously, thus a record not fitting before the end of the buffer is
+ * preceded by a wrap record filling the rest.  'head' and 'tail' count the
+ * bytes written and released since the start, the waiting side sleeps on
+ * the futex 'head_seq' or 'tail_seq', which the other side increments
+ * with every update and wakes if the waiting flag is set.  Compile with
+ * gcc or clang, link with '-lrt' on old systems.
+ */
+#ifndef agf_ring_h_INCLUDED
+#define agf_ring_h_INCLUDED
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define AGF_RING_MAGIC 0x61676672u	/* "agfr" */
+#define AGF_RING_HEADER_SIZE 4096	/* data area starts at this offset */
+#define AGF_RING_ALIGN 16		/* alignment of the records */
+
+struct agf_ring
+{
+  uint32_t magic;		/* AGF_RING_MAGIC once initialized */
+  uint32_t closed;		/* no more mutants are written */
+  uint64_t size;		/* bytes of the data area */
+  uint64_t head;		/* bytes written by the writer */
+  uint64_t tail;		/* bytes released by the reader */
+  uint32_t head_seq;		/* futex, incremented with 'head' */
+  uint32_t tail_seq;		/* futex, incremented with 'tail' */
+  uint32_t reader_waiting;	/* reader sleeps on 'head_seq' */
+  uint32_t writer_waiting;	/* writer sleeps on 'tail_seq' */
+};
+
+struct agf_ring_record
+{
+  uint64_t bytes;		/* size of the mutant */
+  uint32_t seed;		/* seed of the mutant */
+  uint32_t wrap;		/* skip to the start of the buffer */
+};
+
+typedef struct agf_ring_reader
+{
+  struct agf_ring *ring;
+  unsigned char *data;		/* data area */
+  size_t map_size;
+  uint64_t next;		/* position of the current record */
+  uint64_t pending;		/* size of the current record, 0 if none */
+} agf_ring_reader;
+
+static inline uint64_t
+agf_ring_record_size (uint64_t bytes)
+{
+  uint64_t size = sizeof (struct agf_ring_record) + bytes;
+  return (size + AGF_RING_ALIGN - 1) & ~(uint64_t) (AGF_RING_ALIGN - 1);
+}
+
+/* Sleeps while '*addr' is 'val', at most 'ms' milliseconds unless 0. */
+
+static inline void
+agf_ring_futex_wait (uint32_t *addr, uint32_t val, long ms)
+{
+  struct timespec timeout;
+  timeout.tv_sec = ms / 1000;
+  timeout.tv_nsec = (ms % 1000) * 1000000;
+  syscall (SYS_futex, addr, FUTEX_WAIT, val, ms ? &timeout : 0, 0, 0);
+}
+
+/* Increments '*seq' and wakes the other side if it waits. */
+
+static inline void
+agf_ring_futex_wake (uint32_t *seq, uint32_t *waiting)
+{
+  __atomic_add_fetch (seq, 1, __ATOMIC_SEQ_CST);
+  if (__atomic_load_n (waiting, __ATOMIC_SEQ_CST))
+    {
+      __atomic_store_n (waiting, 0, __ATOMIC_SEQ_CST);
+      syscall (SYS_futex, seq, FUTEX_WAKE, 1, 0, 0, 0);
+    }
+}
+
+/* Maps the ring '/<name>', returns 0 on success. */
+
+static inline int
+agf_ring_open (agf_ring_reader *reader, const char *name)
+{
+  char path[256];
+  struct stat st;
+  void *map;
+  int fd;
+
+  snprintf (path, sizeof path, "/%s", name + (name[0] == '/'));
+  fd = shm_open (path, O_RDWR, 0);
+  if (fd < 0)
+    return -1;
+  if (fstat (fd, &st) || st.st_size <= AGF_RING_HEADER_SIZE)
+    {
+      close (fd);
+      return -1;
+    }
+  map = mmap (0, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close (fd);
+  if (map == MAP_FAILED)
+    return -1;
+
+  reader->ring = (struct agf_ring *) map;
+  reader->data = (unsigned char *) map + AGF_RING_HEADER_SIZE;
+  reader->map_size = st.st_size;
+  reader->pending = 0;
+  if (__atomic_load_n (&reader->ring->magic, __ATOMIC_ACQUIRE) !=
+      AGF_RING_MAGIC)
+    {
+      munmap (map, reader->map_size);
+      return -1;
+    }
+  reader->next = __atomic_load_n (&reader->ring->tail, __ATOMIC_ACQUIRE);
+  return 0;
+}
+
+/* Releases the current mutant, such that its space can be reused. */
+
+static inline void
+agf_ring_release (agf_ring_reader *reader)
+{
+  struct agf_ring *ring = reader->ring;
+  if (!reader->pending)
+    return;
+  reader->next += reader->pending;
+  reader->pending = 0;
+  __atomic_store_n (&ring->tail, reader->next, __ATOMIC_RELEASE);
+  agf_ring_futex_wake (&ring->tail_seq, &ring->writer_waiting);
+}
+
+/* Waits for the next mutant and returns a pointer to its bytes in the
+ * ring, valid until 'agf_ring_release'.  Returns 0 if the writer is done
+ * and all mutants are read.  A pending mutant is released first. */
+
+static inline const unsigned char *
+agf_ring_next (agf_ring_reader *reader, size_t *bytes, unsigned *seed)
+{
+  struct agf_ring *ring = reader->ring;
+  const struct agf_ring_record *record;
+  uint64_t head, offset;
+  uint32_t seq;
+
+  agf_ring_release (reader);
+  for (;;)
+    {
+      head = __atomic_load_n (&ring->head, __ATOMIC_ACQUIRE);
+      if (reader->next != head)
+	{
+	  offset = reader->next % ring->size;
+	  record = (const struct agf_ring_record *) (reader->data + offset);
+	  if (record->wrap)
+	    {
+	      reader->pending = ring->size - offset;
+	      agf_ring_release (reader);
+	      continue;
+	    }
+	  reader->pending = agf_ring_record_size (record->bytes);
+	  *bytes = record->bytes;
+	  if (seed)
+	    *seed = record->seed;
+	  return (const unsigned char *) (record + 1);
+	}
+      if (__atomic_load_n (&ring->closed, __ATOMIC_ACQUIRE))
+	{
+	  if (__atomic_load_n (&ring->head, __ATOMIC_ACQUIRE) != reader->next)
+	    continue;
+	  return 0;
+	}
+      seq = __atomic_load_n (&ring->head_seq, __ATOMIC_SEQ_CST);
+      __atomic_store_n (&ring->reader_waiting, 1, __ATOMIC_SEQ_CST);
+      if (__atomic_load_n (&ring->head, __ATOMIC_SEQ_CST) != reader->next ||
+	  __atomic_load_n (&ring->closed, __ATOMIC_SEQ_CST))
+	continue;
+      agf_ring_futex_wait (&ring->head_seq, seq, 0);
+    }
+}
+
+/* Releases the pending mutant and unmaps the ring. */
+
+static inline void
+agf_ring_close (agf_ring_reader *reader)
+{
+  agf_ring_release (reader);
+  munmap (reader->ring, reader->map_size);
+}
+
+#endif
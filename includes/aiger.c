@@ -1606,11 +1606,12 @@ aiger_reencode (aiger * public)
 
   assert (new);
   assert (public->maxvar >= aiger_lit2var (new - 1));
+  old = public->maxvar;
   public->maxvar = aiger_lit2var (new - 1);
 
-  /* Reset types.
+  /* Reset types, including those of discarded variables above 'maxvar'.
    */
-  for (i = 1; i <= public->maxvar; i++)
+  for (i = 1; i <= old; i++)
     {
       type = private->types + i;
       type->input = 0;
@@ -1671,9 +1672,74 @@ const unsigned char *
 aiger_coi (aiger * public)
 {
   IMPORT_private_FROM (public);
+  unsigned i, j, var, top, size_stack, *stack;
+  aiger_symbol *symbol;
+  aiger_type *type;
+  aiger_and *and;
+
+  assert (!aiger_error (public));
+
+  if (private->coi)
+    DELETEN (private->coi, private->size_coi);
+
   private->size_coi = public->maxvar + 1;
   NEWN (private->coi, private->size_coi);
-  memset (private->coi, 1, private->size_coi);
+
+  stack = 0;
+  top = size_stack = 0;
+
+  /* The roots are all outputs and properties.  Latches are not roots, but
+   * once a latch is reached its next state function is traversed too.
+   */
+  for (i = 0; i < public->num_outputs; i++)
+    PUSH (stack, top, size_stack, aiger_lit2var (public->outputs[i].lit));
+
+  for (i = 0; i < public->num_bad; i++)
+    PUSH (stack, top, size_stack, aiger_lit2var (public->bad[i].lit));
+
+  for (i = 0; i < public->num_constraints; i++)
+    PUSH (stack, top, size_stack,
+	  aiger_lit2var (public->constraints[i].lit));
+
+  for (i = 0; i < public->num_justice; i++)
+    for (j = 0; j < public->justice[i].size; j++)
+      PUSH (stack, top, size_stack,
+	    aiger_lit2var (public->justice[i].lits[j]));
+
+  for (i = 0; i < public->num_fairness; i++)
+    PUSH (stack, top, size_stack, aiger_lit2var (public->fairness[i].lit));
+
+  /* Every variable is pushed at most once per fanout edge and expanded at
+   * most once, thus the traversal is linear in the size of the AIG.
+   */
+  while (top > 0)
+    {
+      var = stack[--top];
+      if (!var || private->coi[var])
+	continue;
+
+      assert (var <= public->maxvar);
+      private->coi[var] = 1;
+      type = private->types + var;
+
+      if (type->and)
+	{
+	  assert (type->idx < public->num_ands);
+	  and = public->ands + type->idx;
+	  PUSH (stack, top, size_stack, aiger_lit2var (and->rhs0));
+	  PUSH (stack, top, size_stack, aiger_lit2var (and->rhs1));
+	}
+      else if (type->latch)
+	{
+	  assert (type->idx < public->num_latches);
+	  symbol = public->latches + type->idx;
+	  PUSH (stack, top, size_stack, aiger_lit2var (symbol->next));
+	  PUSH (stack, top, size_stack, aiger_lit2var (symbol->reset));
+	}
+    }
+
+  DELETEN (stack, size_stack);
+
   return private->coi;
 }
 
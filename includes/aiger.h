@@ -276,9 +276,9 @@ void aiger_reencode (aiger *);
  * variable 'v' is in the coi if the array returned as result is non zero at
  * position 'v'. All other variables can be considered redundant.  The array
  * returned is valid until the next call to this function and will be
- * deallocated on reset.
- *
- * TODO: this is just a stub and actually not really implemented yet.
+ * deallocated on reset.  Latches are in the coi if they are reached from
+ * an output or property, in which case their next state and reset
+ * functions are part of the coi too.  The computation is linear.
  */
 const unsigned char * aiger_coi (aiger *);		/* [1..maxvar] */
 
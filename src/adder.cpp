@@ -0,0 +1,237 @@
+/*------------------------------------------------------------------------*/
+/*! \file adder.cpp
+    \brief contains the detection of half and full adders in the AIG
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "adder.h"
+
+#include <stdint.h>
+
+#include <unordered_map>
+
+#include "dedup.h"
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+/**
+    An XOR gate, the literal '2*var' computes XOR(x,y) if 'parity' is 0,
+    and XNOR(x,y) otherwise
+*/
+struct xor_gate {
+  unsigned var;        // /< variable of the top AND gate
+  unsigned x, y;       // /< stripped inputs
+  unsigned parity;     // /< 1 if '2*var' computes XNOR(x,y)
+  unsigned inner[2];   // /< variables of the two inner AND gates
+};
+
+/**
+    A carry OR(AND(x,y), AND(z,w)), where 'w' is XOR(x,y) or OR(x,y)
+*/
+struct carry_gate {
+  unsigned x, y, z;              // /< literals of the inputs
+  unsigned carry;                // /< literal of the carry
+  unsigned half_carry;           // /< literal of AND(x,y)
+  unsigned w;                    // /< literal of XOR(x,y) or OR(x,y)
+  bool w_is_xor;                 // /< 'w' is an XOR gate
+  std::vector<unsigned> gates;   // /< variables of the AND gates
+};
+
+/*------------------------------------------------------------------------*/
+/**
+    Key of an unordered pair of literals
+*/
+static uint64_t pair_key(unsigned a, unsigned b) {
+  if (a < b) { unsigned tmp = a; a = b; b = tmp; }
+  return static_cast<uint64_t>(a) << 32 | b;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Returns the literal of the XOR gate computing XOR(p,q), where 'p' and
+    'q' are the inputs of the gate up to their signs
+*/
+static unsigned xor_literal(const xor_gate & gate, unsigned p, unsigned q) {
+  return (2 * gate.var) ^ gate.parity ^ aiger_sign(p) ^ aiger_sign(q);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Matches AND(!AND(p,q), !AND(!p,!q)), which computes XOR(p,q)
+
+    @return true if 'and_node' is an XOR gate, which is stored in 'res'
+*/
+static bool match_xor(aiger * aig, const aiger_and * and_node,
+  xor_gate & res) {
+  if (!aiger_sign(and_node->rhs0) || !aiger_sign(and_node->rhs1))
+    return false;
+  aiger_and * a0 = aiger_is_and(aig, aiger_strip(and_node->rhs0));
+  aiger_and * a1 = aiger_is_and(aig, aiger_strip(and_node->rhs1));
+  if (!a0 || !a1) return false;
+
+  // XORs of a constant are buffers or inverters
+  unsigned p = a0->rhs0, q = a0->rhs1;
+  if (aiger_strip(p) == aiger_strip(q) || aiger_strip(p) == aiger_false ||
+      aiger_strip(q) == aiger_false) return false;
+  if (pair_key(a1->rhs0, a1->rhs1) != pair_key(aiger_not(p), aiger_not(q)))
+    return false;
+
+  res.var = aiger_lit2var(and_node->lhs);
+  res.x = aiger_strip(p);
+  res.y = aiger_strip(q);
+  res.parity = aiger_sign(p) ^ aiger_sign(q);
+  res.inner[0] = aiger_lit2var(a0->lhs);
+  res.inner[1] = aiger_lit2var(a1->lhs);
+  return true;
+}
+/*------------------------------------------------------------------------*/
+
+void find_adders(aiger * aig, std::vector<adder> & adders) {
+  adders.clear();
+  std::vector<xor_gate> xors;
+  std::vector<carry_gate> carries;
+  std::unordered_map<uint64_t, unsigned> xor_of_pair;   // stripped inputs
+  std::unordered_map<unsigned, unsigned> xor_of_var;
+  std::unordered_map<uint64_t, unsigned> and_of_pair;   // -> lhs
+
+  // returns the XOR gate of the variable of 'w' if it computes XOR(x,y)
+  auto is_xor_of = [&](unsigned w, unsigned x, unsigned y)
+    -> const xor_gate * {
+    auto it = xor_of_var.find(aiger_lit2var(w));
+    if (it == xor_of_var.end()) return 0;
+    const xor_gate & gate = xors[it->second];
+    if (pair_key(gate.x, gate.y) != pair_key(aiger_strip(x), aiger_strip(y)))
+      return 0;
+    if ((gate.parity ^ aiger_sign(w)) != (aiger_sign(x) ^ aiger_sign(y)))
+      return 0;
+    return &gate;
+  };
+  // returns the AND gate of 'w' if 'w' computes OR(x,y)
+  auto is_or_of = [&](unsigned w, unsigned x, unsigned y) -> aiger_and * {
+    if (!aiger_sign(w)) return 0;
+    aiger_and * and_node = aiger_is_and(aig, aiger_strip(w));
+    if (!and_node || pair_key(and_node->rhs0, and_node->rhs1) !=
+        pair_key(aiger_not(x), aiger_not(y))) return 0;
+    return and_node;
+  };
+
+  // single topological pass, the inputs of a gate are matched before it
+  for (unsigned i = 0; i < aig->num_ands; i++) {
+    const aiger_and * and_node = aig->ands + i;
+    and_of_pair.emplace(pair_key(and_node->rhs0, and_node->rhs1),
+      and_node->lhs);
+
+    xor_gate gate;
+    if (match_xor(aig, and_node, gate)) {
+      xor_of_var[gate.var] = xors.size();
+      xor_of_pair.emplace(pair_key(gate.x, gate.y), xors.size());
+      xors.push_back(gate);
+      continue;
+    }
+
+    // the negation of AND(!h1, !h2) is OR(h1, h2)
+    if (!aiger_sign(and_node->rhs0) || !aiger_sign(and_node->rhs1)) continue;
+    aiger_and * a0 = aiger_is_and(aig, aiger_strip(and_node->rhs0));
+    aiger_and * a1 = aiger_is_and(aig, aiger_strip(and_node->rhs1));
+    if (!a0 || !a1) continue;
+
+    bool found = false;
+    for (int k = 0; k < 2 && !found; k++) {
+      aiger_and * h1 = k ? a1 : a0, * h2 = k ? a0 : a1;
+      for (int j = 0; j < 2 && !found; j++) {
+        unsigned z = j ? h2->rhs1 : h2->rhs0, w = j ? h2->rhs0 : h2->rhs1;
+        if (aiger_strip(z) == aiger_false) continue;
+        const xor_gate * xor_w = is_xor_of(w, h1->rhs0, h1->rhs1);
+        aiger_and * or_w = xor_w ? 0 : is_or_of(w, h1->rhs0, h1->rhs1);
+        if (!xor_w && !or_w) continue;
+
+        carry_gate carry;
+        carry.x = h1->rhs0;
+        carry.y = h1->rhs1;
+        carry.z = z;
+        carry.carry = aiger_not(and_node->lhs);
+        carry.half_carry = h1->lhs;
+        carry.w = w;
+        carry.w_is_xor = xor_w;
+        carry.gates = { aiger_lit2var(and_node->lhs), aiger_lit2var(h1->lhs),
+          aiger_lit2var(h2->lhs), aiger_lit2var(w) };
+        if (xor_w) {
+          carry.gates.push_back(xor_w->inner[0]);
+          carry.gates.push_back(xor_w->inner[1]);
+        }
+        carries.push_back(carry);
+        found = true;
+      }
+    }
+  }
+
+  // a full adder is a carry of x, y and z with XOR(XOR(x,y),z), where the
+  // XOR of x and y of the sum may be another gate than the one of the carry
+  for (const carry_gate & carry : carries) {
+    const xor_gate * half = 0, * sum = 0;
+    unsigned half_sum = 0;
+    std::vector<const xor_gate*> halves;
+    auto it = xor_of_pair.find(pair_key(aiger_strip(carry.x),
+      aiger_strip(carry.y)));
+    if (it != xor_of_pair.end()) halves.push_back(&xors[it->second]);
+    if (carry.w_is_xor)
+      halves.push_back(&xors[xor_of_var[aiger_lit2var(carry.w)]]);
+
+    for (const xor_gate * candidate : halves) {
+      half_sum = xor_literal(*candidate, carry.x, carry.y);
+      it = xor_of_pair.find(pair_key(aiger_strip(half_sum),
+        aiger_strip(carry.z)));
+      if (it == xor_of_pair.end()) continue;
+      half = candidate;
+      sum = &xors[it->second];
+      break;
+    }
+    if (!sum) continue;
+
+    adder res;
+    res.inputs[0] = carry.x;
+    res.inputs[1] = carry.y;
+    res.inputs[2] = carry.z;
+    res.sum = xor_literal(*sum, half_sum, carry.z);
+    res.carry = carry.carry;
+    res.half_sum = half_sum;
+    res.half_carry = carry.half_carry;
+    res.gates = carry.gates;
+    res.gates.insert(res.gates.end(), { half->var, half->inner[0],
+      half->inner[1], sum->var, sum->inner[0], sum->inner[1] });
+    adders.push_back(res);
+  }
+
+  // a half adder is an XOR of x and y with AND(x,y), preferably a gate
+  // which is not one of the inner gates of the XOR
+  for (const xor_gate & gate : xors) {
+    unsigned carry = 0, sum = 0, p = 0, q = 0;
+    for (unsigned c = 0; c < 4; c++) {
+      // '2*var^s' computes XOR(x^a, y^b) for all 'a^b == parity^s'
+      unsigned s = c >> 1, a = c & 1;
+      unsigned x = gate.x ^ a, y = gate.y ^ a ^ gate.parity ^ s;
+      auto it = and_of_pair.find(pair_key(x, y));
+      if (it == and_of_pair.end()) continue;
+      unsigned var = aiger_lit2var(it->second);
+      bool inner = var == gate.inner[0] || var == gate.inner[1];
+      if (carry && inner) continue;
+      carry = it->second;
+      sum = (2 * gate.var) ^ s;
+      p = x;
+      q = y;
+      if (!inner) break;
+    }
+    if (!carry) continue;
+
+    adder res;
+    res.inputs[0] = p;
+    res.inputs[1] = q;
+    res.inputs[2] = aiger_false;
+    res.sum = sum;
+    res.carry = carry;
+    res.half_sum = res.half_carry = 0;
+    res.gates = { gate.var, gate.inner[0], gate.inner[1],
+      aiger_lit2var(carry) };
+    adders.push_back(res);
+  }
+}
@@ -0,0 +1,42 @@
+/*------------------------------------------------------------------------*/
+/*! \file adder.h
+    \brief contains the detection of half and full adders in the AIG
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_ADDER_H_
+#define AIGENFUZZER_SRC_ADDER_H_
+/*------------------------------------------------------------------------*/
+#include <vector>
+#include "parser.h"
+/*------------------------------------------------------------------------*/
+
+/**
+    A half or full adder, i.e., sum = XOR(a,b,c) and carry = MAJ(a,b,c).
+    Half adders have the constant 'c = aiger_false'.
+*/
+struct adder {
+  unsigned inputs[3];          // /< literals a, b and c
+  unsigned sum;                // /< literal of the sum
+  unsigned carry;              // /< literal of the carry
+  unsigned half_sum;           // /< literal of XOR(a,b), full adders only
+  unsigned half_carry;         // /< literal of AND(a,b), full adders only
+  std::vector<unsigned> gates; // /< variables of the AND gates of the adder
+};
+
+/**
+    Detects the half and full adders of 'aig' in linear time. XOR and XNOR
+    gates are matched as AND(!AND(x,y), !AND(!x,!y)), carries as
+    OR(AND(x,y), AND(z,w)) where 'w' is XOR(x,y) or OR(x,y). A full adder
+    is a carry of x, y and z together with an XOR of z and XOR(x,y), a half
+    adder an XOR of x and y together with AND(x,y). The half adders inside
+    of full adders are found as well.
+
+    @param aig aiger*, whose AND gates are ordered topologically
+    @param adders vector which is filled with the adders of 'aig'
+*/
+void find_adders(aiger * aig, std::vector<adder> & adders);
+
+#endif  // AIGENFUZZER_SRC_ADDER_H_
@@ -12,11 +12,33 @@
 static const char * USAGE =
 "[agf] \n"
 "[agf] ### USAGE ###\n"
-"[agf] usage : aigofuzzing  <inp> [out] [-h] [-m n] [-s n] [-t n] \n"
+"[agf] usage : aigofuzzing  <inp> [out] [-h] [-m n] [-s n] [-t n] [-o n]\n"
+"[agf]                      [--donor <file>] [--target <metric>]\n"
+"[agf]                      [--max-depth n] [--coi] [--strash]\n"
+"[agf]                      [--cnf] [--cnf-assert] [--poly] [--split <dir>]\n"
+"[agf]         aigofuzzing  --generate <circuit> n [out] [fuzzing options]\n"
+"[agf]         aigofuzzing  <inp> --batch <dir> [-n n] [-j n] [fuzzing options]\n"
+"[agf]         aigofuzzing  <inp> --serve <socket> [fuzzing options]\n"
+"[agf]         aigofuzzing  <inp> --shm <name> [--shm-size n] [-n n]\n"
+"[agf]                      [fuzzing options]\n"
+"[agf]         aigofuzzing  <inp> --diff-test --tool <cmd> [--tool <cmd>]...\n"
+"[agf]                      [-n n] [-j n] [--timeout n] [--memory n]\n"
+"[agf]                      [--results <dir>] [--tmp <dir>] [--forkserver]\n"
+"[agf]                      [--campaign] [--perf <cost>] [--max-ands n]\n"
+"[agf]                      [--adaptive] [--checkpoint n] [--resume]\n"
+"[agf]                      [fuzzing options]\n"
+"[agf]         aigofuzzing  <inp> --spread n --tool <cmd> [--tool <cmd>]...\n"
+"[agf]                      [-j n] [--timeout n] [--memory n]\n"
+"[agf]                      [--results <dir>] [--tmp <dir>] [--forkserver]\n"
+"[agf]                      [fuzzing options]\n"
+"[agf]         aigofuzzing  <dir> --cmin --tool <cmd> [--tool <cmd>]...\n"
+"[agf]                      [-j n] [--timeout n] [--memory n]\n"
+"[agf]                      [--results <dir>] [--tmp <dir>] [--forkserver]\n"
 "[agf] \n"
-"[agf] inp     name of input file\n"
+"[agf] inp     name of input file, '-' reads the AIG from stdin\n"
 "[agf] \n"
-"[agf] out     name of output file\n"
+"[agf] out     name of output file, '-' writes the mutant to stdout and\n"
+"[agf]         all messages to stderr\n"
 "[agf] -h      prints this help\n"
 "[agf] -m n    sets the number of modifications to 'n', default 1 \n"
 "[agf] -s n    sets the seed to 'n'\n"
@@ -25,9 +47,168 @@ static const char * USAGE =
 "[agf]                          2 switch sign of output \n"
 "[agf]                          3 modify input \n"
 "[agf]                          4 insert constant \n"
+"[agf]                          5 crossover \n"
+"[agf]                          6 equivalent rewrite (only if selected)\n"
+"[agf]                          7 modify latch (sequential models)\n"
+"[agf]                          8 modify adder (only if selected)\n"
+"[agf] -o n    sets the selected operator, i.e., sub-variant of a\n"
+"[agf]         technique, to 'n' (default: random technique)\n"
+"[agf]         possible values: 1 flip sign of an edge (technique 1)\n"
+"[agf]                          2 flip sign of a node (technique 1)\n"
+"[agf]                          3 flip sign of an output (technique 2)\n"
+"[agf]                          4 change input (technique 3)\n"
+"[agf]                          5 AND constant zero (technique 4)\n"
+"[agf]                          6 AND constant one (technique 4)\n"
+"[agf]                          7 OR constant zero (technique 4)\n"
+"[agf]                          8 OR constant one (technique 4)\n"
+"[agf]                          9 crossover (technique 5)\n"
+"[agf]                         10 double inversion (technique 6)\n"
+"[agf]                         11 De Morgan (technique 6)\n"
+"[agf]                         12 reassociation (technique 6)\n"
+"[agf]                         13 permute inputs (technique 6)\n"
+"[agf]                         14 permute outputs (technique 6)\n"
+"[agf]                         15 flip latch next state (technique 7)\n"
+"[agf]                         16 change latch next state (technique 7)\n"
+"[agf]                         17 change latch reset (technique 7)\n"
+"[agf]                         18 swap sum and carry (technique 8)\n"
+"[agf]                         19 replace full by half adder (technique 8)\n"
+"[agf]                         20 flip adder output (technique 8)\n"
+"[agf] --donor <file>\n"
+"[agf]         AIG whose cones are spliced into the input by crossover,\n"
+"[agf]         crossover is only chosen randomly if a donor is given,\n"
+"[agf]         otherwise cones of the input itself are used; in a\n"
+"[agf]         campaign the donors are taken from the queue\n"
+"[agf] --target <metric>\n"
+"[agf]         selects the AND gates to modify with a probability\n"
+"[agf]         proportional to 'metric', which is 'uniform' (default),\n"
+"[agf]         'level', 'fanout' or 'observability' (simulated)\n"
+"[agf] --max-depth n\n"
+"[agf]         undoes modifications increasing the depth of the AIG above\n"
+"[agf]         'n', new inputs of AND gates are chosen within the bound\n"
+"[agf] --coi   removes AND gates and latches outside the cone of influence\n"
+"[agf]         of the outputs before writing the fuzzed AIG\n"
+"[agf] --strash\n"
+"[agf]         merges constant, trivial and duplicate AND gates after\n"
+"[agf]         fuzzing, by default such redundant gates are kept\n"
+"[agf] --cnf   writes the fuzzed AIG in DIMACS CNF (Tseitin encoding),\n"
+"[agf]         restricted to the cone of influence with '--coi', in\n"
+"[agf]         diff-test mode the tools get the CNF of the mutants\n"
+"[agf] --cnf-assert\n"
+"[agf]         like '--cnf', and adds a clause asserting that an output\n"
+"[agf]         is true\n"
+"[agf] --poly  writes the fuzzed AIG as gate polynomials '-x + a*b' for\n"
+"[agf]         algebraic verification, followed by the specification of a\n"
+"[agf]         multiplier or adder of the inputs a0.., b0.. if the numbers\n"
+"[agf]         of inputs and outputs fit, in diff-test mode the tools get\n"
+"[agf]         the polynomials of the mutants\n"
+"[agf] --split <dir>\n"
+"[agf]         writes one AIG 'o<i>.aig' per output to 'dir', containing\n"
+"[agf]         only the cone of influence of the output, the files are\n"
+"[agf]         written concurrently by '-j n' threads\n"
+"[agf] --batch <dir>\n"
+"[agf]         writes '-n n' mutants with the seeds s, s+1, ... to 'dir' as\n"
+"[agf]         'mutant-<seed>.aig' ('.cnf', '.poly'), equal to single runs\n"
+"[agf]         with these seeds, the mutants are encoded and written by\n"
+"[agf]         '-j n' threads while the next ones are generated, if 'dir'\n"
+"[agf]         is '-' each mutant is written to stdout as a frame of the\n"
+"[agf]         line '<seed> <bytes>' followed by 'bytes' bytes\n"
+"[agf] --serve <socket>\n"
+"[agf]         keeps the input in memory and answers requests on the Unix\n"
+"[agf]         socket 'socket' until SIGINT or SIGTERM, a request is a line\n"
+"[agf]         '<seed> [<technique> [<modifications>]]', the answer is the\n"
+"[agf]         mutant of a single run with these options as a frame like\n"
+"[agf]         in '--batch -', or a line 'error <reason>'\n"
+"[agf] --shm <name>\n"
+"[agf]         writes '-n n' mutants with the seeds s, s+1, ... into a ring\n"
+"[agf]         buffer in the shared memory object '/name', from which a\n"
+"[agf]         harness reads them in place (see 'includes/agf_ring.h'),\n"
+"[agf]         '-n 0' writes until SIGINT or SIGTERM\n"
+"[agf] --shm-size n\n"
+"[agf]         sets the size of the ring buffer to 'n' MB, default 64\n"
+"[agf] --generate <circuit> n\n"
+"[agf]         builds the circuit with two 'n'-bit operands in memory and\n"
+"[agf]         fuzzes it instead of an input file, 'circuit' is 'array',\n"
+"[agf]         'wallace' or 'booth' (multipliers with 2n outputs), or\n"
+"[agf]         'ripple' or 'cla' (adders with n+1 outputs), can be\n"
+"[agf]         combined with '--diff-test' and '--spread', '-m 0' writes\n"
+"[agf]         the unmodified circuit\n"
+"[agf] \n"
+"[agf] --diff-test\n"
+"[agf]         generates mutants with the seeds s, s+1, ... and runs all\n"
+"[agf]         tools on each mutant in parallel, mutants on which the\n"
+"[agf]         exit codes differ or a tool crashes or times out are stored\n"
+"[agf] --tool <cmd>\n"
+"[agf]         command line of a tool under test, '@@' is replaced by the\n"
+"[agf]         name of the mutant, otherwise the mutant is given on stdin\n"
+"[agf] -n n    sets the number of generated mutants to 'n', default 100\n"
+"[agf] -j n    sets the number of parallel tool runs to 'n',\n"
+"[agf]         default number of cores\n"
+"[agf] --timeout n\n"
+"[agf]         limits each tool run to 'n' seconds\n"
+"[agf] --memory n\n"
+"[agf]         limits each tool run to 'n' MB of virtual memory\n"
+"[agf] --results <dir>\n"
+"[agf]         directory for failing mutants and the log,\n"
+"[agf]         default 'aigofuzzing-results'\n"
+"[agf] --tmp <dir>\n"
+"[agf]         directory for temporary mutants, default '/dev/shm'\n"
+"[agf] --forkserver\n"
+"[agf]         starts each tool once per parallel job and lets it fork a\n"
+"[agf]         fresh copy for each mutant, the tools have to call the\n"
+"[agf]         hook in 'includes/agf_forkserver.h' or be AFL instrumented\n"
+"[agf] --campaign\n"
+"[agf]         coverage-guided campaign, the tools write their edge\n"
+"[agf]         coverage to the AFL bitmap given in '__AFL_SHM_ID'\n"
+"[agf]         (see 'includes/agf_coverage.c'), mutants reaching new edges\n"
+"[agf]         are kept in a queue and further mutants are derived from\n"
+"[agf]         the queue, '-n 0' runs until stopped\n"
+"[agf] --perf <cost>\n"
+"[agf]         perf fuzzing campaign searching for mutants with a high\n"
+"[agf]         cost per variable, where 'cost' is 'time' (CPU time) or\n"
+"[agf]         'memory' (maximum resident set size) of the slowest tool,\n"
+"[agf]         new maxima are kept in the queue and mutated further\n"
+"[agf] --max-ands n\n"
+"[agf]         mutants with more than 'n' AND gates are not kept in perf\n"
+"[agf]         fuzzing, default twice the AND gates of the input\n"
+"[agf] --adaptive\n"
+"[agf]         selects the operator of each mutant with a probability\n"
+"[agf]         following its yield of new coverage, disagreements and\n"
+"[agf]         crashes per CPU-second of the tools, restricted to the\n"
+"[agf]         operators of '-t n' if given\n"
+"[agf] --checkpoint n\n"
+"[agf]         writes a checkpoint to the results directory every 'n'\n"
+"[agf]         seconds, default 300, 0 only writes it at the end and on\n"
+"[agf]         SIGINT or SIGTERM\n"
+"[agf] --resume\n"
+"[agf]         continues the campaign from the checkpoint in the results\n"
+"[agf]         directory, the other options have to be the same, '-n'\n"
+"[agf]         may be increased\n"
+"[agf] \n"
+"[agf] --spread n\n"
+"[agf]         runs all tools on the input and on 'n' equivalent variants\n"
+"[agf]         generated by technique 6 with the seeds s, s+1, ..., and\n"
+"[agf]         reports the spread of the CPU time of each tool, the fastest\n"
+"[agf]         and slowest variants and variants with a different verdict\n"
+"[agf]         are stored, use '-j 1' for stable measurements\n"
+"[agf] \n"
+"[agf] --cmin  runs the instrumented tools on all AIGs in the corpus\n"
+"[agf]         directory 'dir' and copies a subset with the same coverage\n"
+"[agf]         to 'cmin' in the results directory, preferring AIGs with\n"
+"[agf]         fewer AND gates\n"
 "[agf] \n";
 /*------------------------------------------------------------------------*/
-#include "fuzzer.h"
+#include "batch.h"
+#include "cmin.h"
+#include "cnf.h"
+#include "generator.h"
+#include "level.h"
+#include "poly.h"
+#include "ring.h"
+#include "scheduler.h"
+#include "server.h"
+#include "split.h"
+#include "spread.h"
+#include "target.h"
 #include <algorithm>
 #include <climits>
 #include <cstring>
@@ -38,8 +219,13 @@ static const char * USAGE =
 static const char * input_name = 0;
 static const char * output_name = 0;
 static double seed = 0;
-static int technique = 0;
-static int max_tech = 4;
+static int max_tech = 8;
+static bool diff_test = false;
+static bool cmin = false;
+static bool spread = false;
+static int generator = -1;            // /< circuit of '--generate', or -1
+static unsigned generator_width = 0;  // /< bit-width of the operands
+static std::string generator_args;    // /< '--generate <circuit> n'
 
 /*------------------------------------------------------------------------*/
 static bool isNumber(const std::string &s) {
@@ -47,6 +233,27 @@ static bool isNumber(const std::string &s) {
         s.end(), [](unsigned char c) { return !std::isdigit(c); }) == s.end();
 }
 
+/**
+    Returns the nonnegative integer following option 'argv[i]' and
+    increases 'i'.
+*/
+static unsigned get_number_argument(int argc, char ** argv, int & i) {
+  const char * option = argv[i];
+  if(i == argc-1) die("no value for option '%s' given", option);
+
+  if(!isNumber(argv[++i])) die("argument '%s' invalid, \n                  "
+    "option '%s' needs to be followed by a nonnegative integer", argv[i], option);
+  return std::stoul(argv[i], nullptr);
+}
+
+/**
+    Returns the string following option 'argv[i]' and increases 'i'.
+*/
+static const char * get_string_argument(int argc, char ** argv, int & i) {
+  if(i == argc-1) die("no value for option '%s' given", argv[i]);
+  return argv[++i];
+}
+
 /**
     @see init_all_signal_handlers()
 */
@@ -74,30 +281,47 @@ static void init_all() {
 static void reset_all() {
   reset_all_signal_handlers();
   reset_aig_parsing();
+  reset_donor();
 
   reset_time = process_time();
 }
 /*------------------------------------------------------------------------*/
 /**
-    Main Function of AIGoFuzzing.
-    Reads the given AIG and depending on the selected mode, either
-    calls the substution engine or the polynomial solver.
-
-    Prints statistics to stdout after finishing.
+    Reads the input file or generates the circuit of '--generate' into
+    'aiger* model'
 */
-int main(int argc, char ** argv) {
+static void read_input_model() {
+  if (generator >= 0) generate_aig(generator, generator_width);
+  else parse_aig(input_name);
+  if ((cnf_output || poly_output) && L)
+    die("option '--%s' needs a combinational AIG, '%s' has %u latches",
+      cnf_output ? "cnf" : "poly", input_name, L);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Prints the name and version of the tool
+*/
+static void print_banner() {
   msg("AIGoFuzzing " VERSION);
   msg("AIG Generation based Fuzzer");
   msg("Copyright(C) 2022, Daniela Kaufmann, Johannes Kepler University Linz");
   msg("____________________________________________________________________");
   msg("");
   msg("");
+}
+/*------------------------------------------------------------------------*/
+/**
+    Main Function of AIGoFuzzing.
+    Reads the given AIG and depending on the selected mode, either
+    calls the substution engine or the polynomial solver.
 
-  int max = 1;
-
+    Prints statistics to stdout after finishing.
+*/
+int main(int argc, char ** argv) {
   for (int i = 1; i < argc; i++) {
     if (!strcmp(argv[i], "-h") ||
     !strcmp(argv[i], "--help")) {
+      print_banner();
       fputs(USAGE, stdout);
       fflush(stdout);
       exit(0);
@@ -111,6 +335,12 @@ int main(int argc, char ** argv) {
       if (!technique || technique > max_tech) die("argument '%s' invalid, \n         "
         "option '-t' needs to be followed by a number between 1 and %i", argv[i], max_tech);
 
+    } else if (!strcmp(argv[i], "-o")) {
+      fuzz_operator = get_number_argument(argc, argv, i);
+      if (!fuzz_operator || fuzz_operator > NUM_OPERATORS)
+        die("argument '%s' invalid, \n         "
+          "option '-o' needs to be followed by a number between 1 and %i",
+          argv[i], NUM_OPERATORS);
     } else if (!strcmp(argv[i], "-s")) {
       if(i == argc-1) die("no value for option '-s' given");
 
@@ -123,7 +353,91 @@ int main(int argc, char ** argv) {
 
       if(!isNumber(argv[++i])) die("argument '%s' invalid, \n                  "
         "option '-m' needs to be followed by a nonnegative integer", argv[i]);
-      else max = std::stoi(argv[i], nullptr);
+      else modifications = std::stoi(argv[i], nullptr);
+    } else if (!strcmp(argv[i], "--donor")) {
+      donor_name = get_string_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "--target")) {
+      const char * metric = get_string_argument(argc, argv, i);
+      target_metric = parse_target_metric(metric);
+      if (target_metric < 0) die("argument '%s' invalid, \n                  "
+        "option '--target' needs to be followed by 'uniform', 'level', "
+        "'fanout' or 'observability'", metric);
+    } else if (!strcmp(argv[i], "--max-depth")) {
+      max_depth = get_number_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "--generate")) {
+      const char * circuit = get_string_argument(argc, argv, i);
+      generator = parse_generator(circuit);
+      if (generator < 0) die("argument '%s' invalid, \n                  "
+        "option '--generate' needs to be followed by 'array', 'wallace', "
+        "'booth', 'ripple' or 'cla'", circuit);
+      generator_width = get_number_argument(argc, argv, i);
+      if (!generator_width || generator_width > MAX_GEN_WIDTH)
+        die("option '--generate' needs a bit-width between 1 and %u",
+          MAX_GEN_WIDTH);
+      generator_args = std::string("--generate ") + circuit + " " + argv[i];
+    } else if (!strcmp(argv[i], "--coi")) {
+      prune_mutant = true;
+    } else if (!strcmp(argv[i], "--strash")) {
+      strash_mutant = true;
+    } else if (!strcmp(argv[i], "--cnf")) {
+      cnf_output = true;
+    } else if (!strcmp(argv[i], "--cnf-assert")) {
+      cnf_output = cnf_assert = true;
+    } else if (!strcmp(argv[i], "--poly")) {
+      poly_output = true;
+    } else if (!strcmp(argv[i], "--split")) {
+      split_dir = get_string_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "--batch")) {
+      batch_dir = get_string_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "--serve")) {
+      server_socket = get_string_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "--shm")) {
+      ring_name = get_string_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "--shm-size")) {
+      ring_size = get_number_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "--diff-test")) {
+      diff_test = true;
+    } else if (!strcmp(argv[i], "--campaign")) {
+      diff_test = true;
+      collect_coverage = true;
+    } else if (!strcmp(argv[i], "--perf")) {
+      diff_test = true;
+      const char * cost = get_string_argument(argc, argv, i);
+      if (!strcmp(cost, "time")) perf_metric = PERF_TIME;
+      else if (!strcmp(cost, "memory")) perf_metric = PERF_MEMORY;
+      else die("argument '%s' invalid, \n                  "
+        "option '--perf' needs to be followed by 'time' or 'memory'", cost);
+    } else if (!strcmp(argv[i], "--max-ands")) {
+      max_ands = get_number_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "--adaptive")) {
+      adaptive_scheduling = true;
+    } else if (!strcmp(argv[i], "--checkpoint")) {
+      checkpoint_interval = get_number_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "--resume")) {
+      resume_campaign = true;
+    } else if (!strcmp(argv[i], "--spread")) {
+      spread = true;
+      num_variants = get_number_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "--cmin")) {
+      cmin = true;
+      collect_coverage = true;
+    } else if (!strcmp(argv[i], "--tool")) {
+      tools.push_back(parse_tool(get_string_argument(argc, argv, i)));
+    } else if (!strcmp(argv[i], "-n")) {
+      num_mutants = get_number_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "-j")) {
+      max_jobs = get_number_argument(argc, argv, i);
+      if (!max_jobs) die("option '-j' needs a positive number");
+    } else if (!strcmp(argv[i], "--timeout")) {
+      time_limit = get_number_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "--memory")) {
+      memory_limit = get_number_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "--results")) {
+      results_dir = get_string_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "--tmp")) {
+      tmp_dir = get_string_argument(argc, argv, i);
+    } else if (!strcmp(argv[i], "--forkserver")) {
+      use_forkserver = true;
     } else if (output_name) {
       die("too many arguments '%s', '%s' and '%s'(try '-h')",
         input_name, output_name, argv[i]);
@@ -133,38 +447,118 @@ int main(int argc, char ** argv) {
     }
   }
 
+  if (generator >= 0) {
+    // the arguments replace the input file, also in the reproduce lines
+    if (output_name)
+      die("too many arguments '%s' and '%s' with '--generate' (try '-h')",
+        input_name, output_name);
+    if (cmin) die("options '--cmin' and '--generate' are exclusive (try '-h')");
+    output_name = input_name;
+    input_name = generator_args.c_str();
+  }
   if (!input_name)  die("no input file given(try '-h')");
+  if (donor_name && is_standard_stream(donor_name) &&
+      is_standard_stream(input_name))
+    die("the input and the donor can not both be read from stdin");
+  if (diff_test && output_name)
+    die("unexpected output file '%s' in diff-test mode (try '-h')", output_name);
+  if (cmin && output_name)
+    die("unexpected argument '%s' in cmin mode (try '-h')", output_name);
+  if (adaptive_scheduling && !diff_test)
+    die("option '--adaptive' needs '--diff-test', '--campaign' or '--perf'");
+  if (adaptive_scheduling && fuzz_operator)
+    die("options '--adaptive' and '-o' are exclusive (try '-h')");
+  if (resume_campaign && !diff_test)
+    die("option '--resume' needs '--diff-test', '--campaign' or '--perf'");
+  if (perf_metric && use_forkserver)
+    die("option '--perf' needs the resource usage of the tools, "
+      "which is not available with '--forkserver'");
+  if (donor_name && (collect_coverage || perf_metric))
+    die("option '--donor' can not be used in a campaign, "
+      "the donors are taken from the queue");
+  if (cmin && diff_test)
+    die("options '--cmin' and '--diff-test' are exclusive (try '-h')");
+  if (spread && (cmin || diff_test))
+    die("option '--spread' is exclusive to '--cmin' and '--diff-test' "
+      "(try '-h')");
+  if (spread && output_name)
+    die("unexpected argument '%s' in spread mode (try '-h')", output_name);
+  if (spread && ((fuzz_operator && operator_technique(fuzz_operator) != 6) ||
+      (technique && technique != 6)))
+    die("option '--spread' needs an equivalent rewrite (technique 6)");
+  if (spread && !fuzz_operator) technique = 6;
+  if (cnf_output && (spread || cmin))
+    die("option '--cnf' needs a single run, '--batch' or '--diff-test' "
+      "(try '-h')");
+  if (poly_output && (spread || cmin))
+    die("option '--poly' needs a single run, '--batch' or '--diff-test' "
+      "(try '-h')");
+  if (split_dir && (diff_test || spread || cmin))
+    die("option '--split' needs a single run (try '-h')");
+  if (batch_dir && (diff_test || spread || cmin || split_dir))
+    die("option '--batch' is exclusive to '--diff-test', '--spread', "
+      "'--cmin' and '--split' (try '-h')");
+  if (batch_dir && output_name)
+    die("unexpected argument '%s' in batch mode (try '-h')", output_name);
+  if (server_socket && (diff_test || spread || cmin || split_dir || batch_dir))
+    die("option '--serve' is exclusive to '--diff-test', '--spread', "
+      "'--cmin', '--split' and '--batch' (try '-h')");
+  if (server_socket && output_name)
+    die("unexpected argument '%s' in server mode (try '-h')", output_name);
+  if (ring_name && (diff_test || spread || cmin || split_dir || batch_dir ||
+      server_socket))
+    die("option '--shm' is exclusive to '--diff-test', '--spread', "
+      "'--cmin', '--split', '--batch' and '--serve' (try '-h')");
+  if (ring_name && output_name)
+    die("unexpected argument '%s' in shared-memory mode (try '-h')",
+      output_name);
+  if (poly_output && cnf_output)
+    die("options '--poly' and '--cnf' are exclusive (try '-h')");
+  // the bit-width of a generated adder is not ambiguous for one bit
+  if (generator >= 0)
+    poly_spec = generator >= GEN_RIPPLE ? POLY_SPEC_ADD : POLY_SPEC_MULT;
+  // the banner is printed after the options, which decide where it goes
+  if ((output_name && is_standard_stream(output_name)) ||
+      (batch_dir && is_standard_stream(batch_dir)))
+    messages_to_stderr = true;
 
+  print_banner();
   init_all();
-  parse_aig(input_name);
 
-  int sel_tech = technique;
-
-  for(int i = 0; i < max; i++){
-    if(!technique){
-      sel_tech = rangeRandomZeroMax(4) + 1;
-    }
+  if (cmin) {
+    run_corpus_minimization(input_name);
+  } else if (spread) {
+    read_input_model();
+    run_spread_test(input_name, seed);
+  } else if (ring_name) {
+    read_input_model();
+    if (donor_name) load_donor();
+    run_ring(seed);
+  } else if (server_socket) {
+    read_input_model();
+    if (donor_name) load_donor();
+    run_server(max_tech);
+  } else if (batch_dir) {
+    read_input_model();
+    if (donor_name) load_donor();
+    run_batch(seed);
+  } else if (diff_test) {
+    read_input_model();
+    if (donor_name) load_donor();
+    run_diff_test(input_name, seed);
+  } else {
+    read_input_model();
+    if (donor_name) load_donor();
+    fuzz_model();
 
-    switch(sel_tech){
-      case 1:
-        flip_internal_sign();
-        break;
-      case 2:
-        flip_output_sign();
-        break;
-      case 3:
-        change_input_of_internal_node();
-        break;
-      case 4:
-        insert_constant();
-        break;
+    if(output_name && cnf_output) { write_fuzzed_cnf(output_name);
+    } else if(output_name && poly_output) { write_fuzzed_poly(output_name);
+    } else if(output_name) { write_fuzzed_model(output_name);
+    } else if(!split_dir) {
+      msg("WARNING: No output file given. Nothing will be printed.");
+      msg("");
     }
-  }
-
-  if(output_name) { write_fuzzed_model(output_name);
-  } else {
-    msg("WARNING: No output file given. Nothing will be printed.");
-    msg("");
+    if(split_dir) write_output_cones();
   }
 
   reset_all();
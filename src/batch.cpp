@@ -0,0 +1,162 @@
+/*------------------------------------------------------------------------*/
+/*! \file batch.cpp
+    \brief contains the pipelined generation and writing of many mutants
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "batch.h"
+
+#include <stdio.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cnf.h"
+#include "dedup.h"
+#include "difftest.h"
+#include "poly.h"
+/*------------------------------------------------------------------------*/
+// Global Variables
+const char * batch_dir = 0;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+/**
+    A generated mutant waiting to be written, owned by the queue
+*/
+struct batch_job {
+  aiger * aig;      // /< the mutant, deallocated by the writer
+  unsigned seed;    // /< seed of the mutant, names the file
+};
+
+/**
+    Bounded queue between the generating main thread and the writers
+*/
+static struct {
+  std::mutex lock;
+  std::condition_variable not_empty;   // /< signalled on push and close
+  std::condition_variable not_full;    // /< signalled on pop
+  std::deque<batch_job> jobs;
+  size_t capacity;
+  bool closed;                         // /< no more mutants are generated
+} queue;
+
+static std::mutex stream_lock;   // /< writers of frames to stdout
+
+
+/*------------------------------------------------------------------------*/
+/**
+    Appends 'job', waits while the queue is full
+*/
+static void push_job(const batch_job & job) {
+  std::unique_lock<std::mutex> guard(queue.lock);
+  queue.not_full.wait(guard,
+    []() { return queue.jobs.size() < queue.capacity; });
+  queue.jobs.push_back(job);
+  queue.not_empty.notify_one();
+}
+/*------------------------------------------------------------------------*/
+/**
+    Takes the first job of the queue, waits while it is empty
+
+    @return false if the queue is empty and closed
+*/
+static bool pop_job(batch_job & job) {
+  std::unique_lock<std::mutex> guard(queue.lock);
+  queue.not_empty.wait(guard,
+    []() { return !queue.jobs.empty() || queue.closed; });
+  if (queue.jobs.empty()) return false;
+  job = queue.jobs.front();
+  queue.jobs.pop_front();
+  queue.not_full.notify_one();
+  return true;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Writes the frame of the mutant with the given seed to stdout and flushes
+    it, such that the reader gets complete mutants without delay
+*/
+static void write_frame(unsigned seed, const std::string & data) {
+  std::lock_guard<std::mutex> guard(stream_lock);
+  if (printf("%u %zu\n", seed, data.size()) < 0 ||
+      fwrite(data.data(), 1, data.size(), stdout) != data.size() ||
+      fflush(stdout))
+    die("failed to write mutant %u to stdout", seed);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Encodes and writes the mutants of the queue until it is closed
+*/
+static void write_jobs() {
+  const char * extension = cnf_output ? "cnf" : poly_output ? "poly" : "aig";
+  std::string buffer;
+  batch_job job;
+  while (pop_job(job)) {
+    if (cnf_output) write_cnf_to_buffer(job.aig, buffer);
+    else if (poly_output) write_poly_to_buffer(job.aig, buffer);
+    else write_aiger_to_buffer(job.aig, buffer);
+    aiger_reset(job.aig);
+    if (is_standard_stream(batch_dir)) {
+      write_frame(job.seed, buffer);
+      continue;
+    }
+
+    char path[4096];
+    snprintf(path, sizeof path, "%s/mutant-%u.%s",
+      batch_dir, job.seed, extension);
+    write_buffer_to_file(path, buffer);
+  }
+}
+/*------------------------------------------------------------------------*/
+
+unsigned run_batch(unsigned seed) {
+  assert(batch_dir);
+  if (!num_mutants) die("option '--batch' needs a positive number '-n n'");
+  if (!is_standard_stream(batch_dir)) make_directory(batch_dir);
+  unsigned num_threads = max_jobs ? max_jobs : number_of_cores();
+
+  msg("Batch");
+  msg("==========================================================");
+  msg("  Mutants:         %u", num_mutants);
+  msg("  Writer threads:  %u", num_threads);
+  if (is_standard_stream(batch_dir)) msg("  Output:          framed on stdout");
+  else msg("  Output dir:      '%s'", batch_dir);
+  msg("");
+
+  store_base_model();
+  uint64_t base_hash = hash_aiger(base_model);
+
+  queue.capacity = 2 * num_threads;
+  queue.closed = false;
+  std::vector<std::thread> writers;
+  for (unsigned i = 0; i < num_threads; i++) writers.emplace_back(write_jobs);
+
+  for (unsigned i = 0; i < num_mutants; i++) {
+    quiet = true;
+    generate_mutant(base_model, base_hash, seed + i);
+    quiet = false;
+    // the writer owns the mutant, the next one is a fresh copy anyway
+    push_job({ model, seed + i });
+    model = 0;
+  }
+  {
+    std::lock_guard<std::mutex> guard(queue.lock);
+    queue.closed = true;
+  }
+  queue.not_empty.notify_all();
+  for (std::thread & writer : writers) writer.join();
+
+  msg("Output");
+  msg("==========================================================");
+  if (is_standard_stream(batch_dir))
+    msg("  Printed %u mutants to stdout", num_mutants);
+  else msg("  Printed %u mutants to: '%s'", num_mutants, batch_dir);
+  msg("");
+  return num_mutants;
+}
@@ -0,0 +1,36 @@
+/*------------------------------------------------------------------------*/
+/*! \file batch.h
+    \brief contains the pipelined generation and writing of many mutants
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_BATCH_H_
+#define AIGENFUZZER_SRC_BATCH_H_
+/*------------------------------------------------------------------------*/
+#include "fuzzer.h"
+/*------------------------------------------------------------------------*/
+
+extern const char * batch_dir;   // /< directory of the batch mutants, or 0
+
+/**
+    Generates 'num_mutants' mutants of 'aiger* model' with the seeds 'seed',
+    'seed+1', ... and writes them to 'batch_dir' as 'mutant-<seed>.aig',
+    '.cnf' or '.poly'. Each mutant is the same as written by a single run
+    with this seed. If 'batch_dir' is '-', the mutants are written to
+    stdout instead, each as a frame of the header line '<seed> <bytes>'
+    followed by the 'bytes' bytes of the mutant, in the order in which
+    they are written. The mutants are generated by the main thread, since
+    the fuzzer works on 'aiger* model', and handed over without a copy to
+    'max_jobs' writer threads, default number of cores, which encode and
+    write them. At most two mutants per writer wait in the queue, thus the
+    generation is paused while the writers are behind.
+
+    @param seed unsigned integer, seed of the first mutant
+
+    @return number of written files
+*/
+unsigned run_batch(unsigned seed);
+
+#endif  // AIGENFUZZER_SRC_BATCH_H_
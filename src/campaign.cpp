@@ -0,0 +1,139 @@
+/*------------------------------------------------------------------------*/
+/*! \file campaign.cpp
+    \brief contains the queue of interesting mutants of a coverage-guided
+           campaign
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "campaign.h"
+
+#include "dedup.h"
+/*------------------------------------------------------------------------*/
+// Global Variables
+std::vector<queue_entry> campaign_queue;
+uint64_t campaign_rng = 0;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+static std::string queue_dir;   // /< directory of the queue entries
+static unsigned next_entry;     // /< next entry selected for mutation
+static unsigned fittest_entry;  // /< entry with the highest fitness
+
+/*------------------------------------------------------------------------*/
+/**
+    Returns the file of the queue entry with the given index
+*/
+static std::string queue_entry_path(size_t idx) {
+  char path[4096];
+  snprintf(path, sizeof path, "%s/id-%06zu.aig", queue_dir.c_str(), idx);
+  return path;
+}
+/*------------------------------------------------------------------------*/
+
+void init_queue(const char * dir) {
+  assert(base_model);
+  assert(campaign_queue.empty());
+
+  queue_dir = std::string(dir) + "/queue";
+  make_directory(queue_dir.c_str());
+
+  std::string data;
+  load_model(base_model);
+  write_model_to_buffer(data);
+  add_queue_entry(data, 0, 0, 0, 0);
+  next_entry = fittest_entry = 0;
+}
+/*------------------------------------------------------------------------*/
+
+void reset_queue() {
+  for (queue_entry & entry : campaign_queue) aiger_reset(entry.aig);
+  campaign_queue.clear();
+}
+/*------------------------------------------------------------------------*/
+
+unsigned select_queue_entry() {
+  assert(!campaign_queue.empty());
+  if (next_entry >= campaign_queue.size()) next_entry = 0;
+  return next_entry++;
+}
+/*------------------------------------------------------------------------*/
+
+uint64_t campaign_random() {
+  // splitmix64
+  uint64_t res = (campaign_rng += 0x9e3779b97f4a7c15ull);
+  res = (res ^ (res >> 30)) * 0xbf58476d1ce4e5b9ull;
+  res = (res ^ (res >> 27)) * 0x94d049bb133111ebull;
+  return res ^ (res >> 31);
+}
+/*------------------------------------------------------------------------*/
+
+unsigned select_fittest_queue_entry() {
+  if (campaign_random() & 1) return fittest_entry;
+  return select_queue_entry();
+}
+/*------------------------------------------------------------------------*/
+
+unsigned select_donor_queue_entry(unsigned parent) {
+  assert(!campaign_queue.empty());
+  if (campaign_queue.size() == 1) return 0;
+  unsigned res = campaign_random() % (campaign_queue.size() - 1);
+  return res < parent ? res : res + 1;
+}
+/*------------------------------------------------------------------------*/
+
+void add_queue_entry(const std::string & data, unsigned parent,
+  unsigned seed, unsigned edges, double fitness) {
+  queue_entry entry;
+  entry.aig = read_aiger_from_buffer(data);
+  entry.parent = parent;
+  entry.seed = seed;
+  entry.edges = edges;
+  entry.fitness = fitness;
+  entry.hash = hash_aiger(entry.aig);
+
+  entry.path = queue_entry_path(campaign_queue.size());
+  write_buffer_to_file(entry.path.c_str(), data);
+
+  if (!campaign_queue.empty() &&
+      fitness > campaign_queue[fittest_entry].fitness)
+    fittest_entry = campaign_queue.size();
+  campaign_queue.push_back(entry);
+}
+/*------------------------------------------------------------------------*/
+
+void save_queue(FILE * file) {
+  fprintf(file, "queue %zu %u %u\n", campaign_queue.size(),
+    next_entry, fittest_entry);
+  for (const queue_entry & entry : campaign_queue)
+    fprintf(file, "%u %u %u %.17g\n", entry.parent, entry.seed,
+      entry.edges, entry.fitness);
+}
+/*------------------------------------------------------------------------*/
+
+bool load_queue(FILE * file) {
+  size_t size;
+  unsigned next, fittest;
+  if (fscanf(file, " queue %zu %u %u", &size, &next, &fittest) != 3 ||
+      !size || fittest >= size)
+    return false;
+
+  reset_queue();
+  std::string data;
+  for (size_t i = 0; i < size; i++) {
+    queue_entry entry;
+    if (fscanf(file, "%u %u %u %lg", &entry.parent, &entry.seed,
+        &entry.edges, &entry.fitness) != 4)
+      return false;
+    entry.path = queue_entry_path(i);
+    read_file_to_buffer(entry.path.c_str(), data);
+    entry.aig = read_aiger_from_buffer(data);
+    entry.hash = hash_aiger(entry.aig);
+    campaign_queue.push_back(entry);
+  }
+  next_entry = next;
+  fittest_entry = fittest;
+  return true;
+}
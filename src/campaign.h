@@ -0,0 +1,107 @@
+/*------------------------------------------------------------------------*/
+/*! \file campaign.h
+    \brief contains the queue of interesting mutants of a coverage-guided
+           campaign
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_CAMPAIGN_H_
+#define AIGENFUZZER_SRC_CAMPAIGN_H_
+/*------------------------------------------------------------------------*/
+#include <vector>
+
+#include "parser.h"
+/*------------------------------------------------------------------------*/
+
+/**
+    A mutant that reached new coverage. Further mutants are derived from it.
+*/
+struct queue_entry {
+  aiger * aig;          // /< the mutant
+  std::string path;     // /< file of the mutant in the queue directory
+  unsigned parent;      // /< index of the queue entry it was derived from
+  unsigned seed;        // /< seed used to derive it from the parent
+  unsigned edges;       // /< number of edges it covers
+  double fitness;       // /< cost per variable in a perf fuzzing campaign
+  uint64_t hash;        // /< structural hash of the mutant
+};
+
+extern std::vector<queue_entry> campaign_queue;  // /< entry 0 is the input
+extern uint64_t campaign_rng;   // /< state of 'campaign_random'
+
+/**
+    Returns a random number for the scheduling decisions of a campaign.
+    These are drawn from a separate stream, which does not depend on the
+    seeds of the mutants and is restored when a campaign is resumed.
+*/
+uint64_t campaign_random();
+
+/**
+    Initializes the queue with a copy of 'aiger* base_model', and creates
+    the queue directory in 'dir'.
+
+    @param dir results directory
+*/
+void init_queue(const char * dir);
+
+/**
+    Deallocates the queue
+*/
+void reset_queue();
+
+/**
+    Selects the next queue entry to mutate, cycling through the queue.
+
+    @return index of the queue entry
+*/
+unsigned select_queue_entry();
+
+/**
+    Selects the next queue entry to mutate in a perf fuzzing campaign. The
+    fittest entry is selected in half of the cases, otherwise the next
+    entry as in 'select_queue_entry'.
+
+    @return index of the queue entry
+*/
+unsigned select_fittest_queue_entry();
+
+/**
+    Selects the donor of a crossover, a random queue entry different from
+    'parent' if the queue contains more than one entry.
+
+    @param parent index of the queue entry that is mutated
+    @return index of the queue entry
+*/
+unsigned select_donor_queue_entry(unsigned parent);
+
+/**
+    Adds a mutant to the queue and writes it to the queue directory.
+
+    @param data binary AIGER encoding of the mutant
+    @param parent index of the queue entry it was derived from
+    @param seed seed used to derive it from the parent
+    @param edges number of edges it covers
+    @param fitness cost per variable, 0 if not measured
+*/
+void add_queue_entry(const std::string & data, unsigned parent,
+  unsigned seed, unsigned edges, double fitness);
+
+/**
+    Writes the queue to a checkpoint. The mutants themselves are already
+    stored in the queue directory.
+
+    @param file checkpoint opened for writing
+*/
+void save_queue(FILE * file);
+
+/**
+    Restores the queue from a checkpoint, replacing the initialized queue.
+
+    @param file checkpoint opened for reading
+    @return false if the checkpoint is malformed
+*/
+bool load_queue(FILE * file);
+
+#endif  // AIGENFUZZER_SRC_CAMPAIGN_H_
@@ -0,0 +1,239 @@
+/*------------------------------------------------------------------------*/
+/*! \file cmin.cpp
+    \brief contains the coverage-based minimization of a corpus of AIGs
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "cmin.h"
+
+#include <dirent.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+/**
+    An AIG of the corpus together with the coverage of all tools on it
+*/
+struct corpus_entry {
+  std::string name;                // /< file name in the corpus directory
+  std::string path;                // /< path of the file
+  unsigned ands;                   // /< number of AND gates from the header
+  size_t size;                     // /< file size in bytes
+  std::vector<uint32_t> features;  // /< covered (tool, edge, bucket) tuples
+};
+
+static std::vector<corpus_entry> corpus;
+
+static unsigned skipped, tool_runs, crashes, timeouts;
+
+/*------------------------------------------------------------------------*/
+/**
+    Reads the number of AND gates from the header of an AIGER file.
+
+    @return false if the file does not start with an AIGER header
+*/
+static bool read_and_count(const char * path, unsigned & ands) {
+  FILE * file = fopen(path, "r");
+  if (!file) return false;
+  char format[4];
+  unsigned m, i, l, o;
+  int res = fscanf(file, "%3s %u %u %u %u %u", format, &m, &i, &l, &o, &ands);
+  fclose(file);
+  return res == 6 && (!strcmp(format, "aag") || !strcmp(format, "aig"));
+}
+/*------------------------------------------------------------------------*/
+/**
+    Collects the AIGER files of the corpus directory in 'corpus', sorted by
+    name to make the selection independent of the directory order.
+*/
+static void read_corpus(const char * corpus_dir) {
+  DIR * dir = opendir(corpus_dir);
+  if (!dir) die("can not open corpus directory '%s'", corpus_dir);
+
+  while (struct dirent * ent = readdir(dir)) {
+    if (ent->d_name[0] == '.') continue;
+    corpus_entry entry;
+    entry.name = ent->d_name;
+    entry.path = std::string(corpus_dir) + "/" + entry.name;
+
+    struct stat st;
+    if (stat(entry.path.c_str(), &st) || !S_ISREG(st.st_mode)) continue;
+    entry.size = st.st_size;
+
+    if (!read_and_count(entry.path.c_str(), entry.ands)) {
+      msg("  skipping '%s' (no AIGER header)", entry.path.c_str());
+      skipped++;
+      continue;
+    }
+    corpus.push_back(entry);
+  }
+  closedir(dir);
+
+  std::sort(corpus.begin(), corpus.end(),
+    [](const corpus_entry & a, const corpus_entry & b) {
+      return a.name < b.name; });
+}
+/*------------------------------------------------------------------------*/
+/**
+    Starts the given tool on a corpus entry. The file content is only
+    needed by the fork servers.
+*/
+static void start_corpus_run(unsigned idx, unsigned tool_idx) {
+  std::string data;
+  if (use_forkserver) read_file_to_buffer(corpus[idx].path.c_str(), data);
+  execute_tool(tools[tool_idx], tool_idx, corpus[idx].path.c_str(), data, idx);
+  tool_runs++;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Adds the classified edges of a terminated tool to the features of its
+    corpus entry. The edge bitmap of a killed tool is incomplete and ignored.
+*/
+static void handle_corpus_run(const tool_run & run) {
+  if (run.timeout) { timeouts++; return; }
+  if (WIFSIGNALED(run.status)) crashes++;
+  else if (WEXITSTATUS(run.status) == 127)
+    die("tool '%s' could not be executed", tools[run.tool_idx].command.c_str());
+
+  classify_counts(run.trace_bits);
+  std::vector<uint32_t> & features = corpus[run.job].features;
+  for (uint32_t i = 0; i < COVERAGE_MAP_SIZE; i++) {
+    unsigned char bucket = run.trace_bits[i];
+    if (!bucket) continue;
+    uint32_t edge = run.tool_idx * COVERAGE_MAP_SIZE + i;
+    for (uint32_t bit = 0; bit < 8; bit++)
+      if (bucket & (1u << bit)) features.push_back(edge << 3 | bit);
+  }
+}
+/*------------------------------------------------------------------------*/
+/**
+    Returns true if corpus entry 'a' is preferred over 'b', i.e., if it has
+    fewer AND gates, or is smaller on equal AND gates.
+*/
+static bool is_smaller(const corpus_entry & a, const corpus_entry & b) {
+  if (a.ands != b.ands) return a.ands < b.ands;
+  if (a.size != b.size) return a.size < b.size;
+  return a.name < b.name;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Selects the corpus entries of the minimized corpus as in 'afl-cmin':
+    each feature is assigned to the smallest entry covering it, then the
+    features are traversed and the assigned entry of each feature that is
+    not covered yet is selected.
+
+    @param num_features set to the number of different features
+    @return indices of the selected entries
+*/
+static std::vector<unsigned> select_minimal_subset(size_t & num_features) {
+  std::unordered_map<uint32_t, unsigned> smallest;
+  for (unsigned i = 0; i < corpus.size(); i++) {
+    for (uint32_t f : corpus[i].features) {
+      auto it = smallest.find(f);
+      if (it == smallest.end()) smallest[f] = i;
+      else if (is_smaller(corpus[i], corpus[it->second])) it->second = i;
+    }
+  }
+  num_features = smallest.size();
+
+  // traverse features in a fixed order to obtain reproducible results
+  std::vector<uint32_t> features;
+  features.reserve(smallest.size());
+  for (const auto & it : smallest) features.push_back(it.first);
+  std::sort(features.begin(), features.end());
+
+  std::unordered_set<uint32_t> covered;
+  std::vector<bool> selected(corpus.size());
+  std::vector<unsigned> res;
+  for (uint32_t f : features) {
+    if (covered.count(f)) continue;
+    unsigned idx = smallest[f];
+    assert(!selected[idx]);
+    selected[idx] = true;
+    res.push_back(idx);
+    covered.insert(corpus[idx].features.begin(), corpus[idx].features.end());
+  }
+  std::sort(res.begin(), res.end());
+  return res;
+}
+/*------------------------------------------------------------------------*/
+
+void run_corpus_minimization(const char * corpus_dir) {
+  if (tools.empty()) die("no tool given for corpus minimization (try '-h')");
+
+  read_corpus(corpus_dir);
+  if (corpus.empty()) die("no AIGER files found in '%s'", corpus_dir);
+
+  make_directory(results_dir);
+  std::string cmin_dir = std::string(results_dir) + "/cmin";
+  make_directory(cmin_dir.c_str());
+
+  init_executor();
+  init_coverage();
+
+  msg("Corpus minimization");
+  msg("==========================================================");
+  msg("  Tools:           %zu", tools.size());
+  for (const tool & t : tools) msg("                   '%s'", t.command.c_str());
+  msg("  Corpus:          '%s' (%zu files)", corpus_dir, corpus.size());
+  msg("  Parallel jobs:   %u", max_jobs);
+  msg("  Output dir:      '%s'", cmin_dir.c_str());
+  msg("");
+
+  double start = wall_clock_time();
+
+  size_t total_runs = corpus.size() * tools.size();
+  for (size_t next = 0; next < total_runs || executor_running(); ) {
+    if (next < total_runs && !executor_full()) {
+      start_corpus_run(next / tools.size(), next % tools.size());
+      next++;
+      continue;
+    }
+    tool_run run;
+    if (collect_tool_run(run, true)) handle_corpus_run(run);
+  }
+
+  reset_executor();
+
+  size_t num_features;
+  std::vector<unsigned> subset = select_minimal_subset(num_features);
+  if (!num_features)
+    msg("  WARNING: no coverage collected, are the tools instrumented?");
+
+  unsigned ands = 0, selected_ands = 0;
+  for (const corpus_entry & entry : corpus) ands += entry.ands;
+
+  std::string data;
+  for (unsigned idx : subset) {
+    const corpus_entry & entry = corpus[idx];
+    read_file_to_buffer(entry.path.c_str(), data);
+    write_buffer_to_file((cmin_dir + "/" + entry.name).c_str(), data);
+    selected_ands += entry.ands;
+  }
+
+  double elapsed = wall_clock_time() - start;
+
+  msg("");
+  msg("  corpus files:    %zu", corpus.size());
+  msg("  skipped files:   %u", skipped);
+  msg("  tool runs:       %u", tool_runs);
+  msg("  crashes:         %u", crashes);
+  msg("  timeouts:        %u", timeouts);
+  msg("  tuples:          %zu", num_features);
+  msg("  selected files:  %zu", subset.size());
+  msg("  AND gates:       %u of %u", selected_ands, ands);
+  msg("  wall clock time: %.2f seconds (%.1f files per second)",
+    elapsed, elapsed > 0 ? corpus.size() / elapsed : 0);
+  msg("");
+
+  corpus.clear();
+}
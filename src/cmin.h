@@ -0,0 +1,26 @@
+/*------------------------------------------------------------------------*/
+/*! \file cmin.h
+    \brief contains the coverage-based minimization of a corpus of AIGs
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_CMIN_H_
+#define AIGENFUZZER_SRC_CMIN_H_
+/*------------------------------------------------------------------------*/
+#include "difftest.h"
+/*------------------------------------------------------------------------*/
+
+/**
+    Runs all tools on every AIG in the directory 'corpus_dir' in a bounded
+    process pool and collects their edge bitmaps. Then selects a subset of
+    the corpus that covers the same edges and hit count buckets, where for
+    each edge the AIG with the fewest AND gates is preferred. The subset
+    is copied to the directory 'cmin' in 'results_dir'.
+
+    @param corpus_dir directory of the corpus
+*/
+void run_corpus_minimization(const char * corpus_dir);
+
+#endif  // AIGENFUZZER_SRC_CMIN_H_
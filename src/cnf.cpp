@@ -0,0 +1,112 @@
+/*------------------------------------------------------------------------*/
+/*! \file cnf.cpp
+    \brief contains the Tseitin encoding of the AIG in DIMACS CNF
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "cnf.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <initializer_list>
+#include <vector>
+/*------------------------------------------------------------------------*/
+// Global Variables
+bool cnf_output = false;
+bool cnf_assert = false;
+
+/*------------------------------------------------------------------------*/
+/**
+    Appends the clause of 'lits', terminated by 0
+*/
+static void put_clause(buffered_writer & out,
+  std::initializer_list<int64_t> lits) {
+  for (int64_t lit : lits) {
+    out.put_int(lit);
+    out.buffer.push_back(' ');
+  }
+  out.buffer += "0\n";
+  out.flush_if_full();
+}
+/*------------------------------------------------------------------------*/
+/**
+    Encodes 'aig' with the given writer
+*/
+static void encode_aiger(aiger * aig, buffered_writer & out) {
+  if (aig->num_latches)
+    die("DIMACS CNF needs a combinational AIG, the AIG has %u latches",
+      aig->num_latches);
+
+  // CNF variables of the AIG variables, the constant is added on demand
+  std::vector<int64_t> var(aig->maxvar + 1, 0);
+  int64_t num_vars = 0;
+  for (unsigned i = 0; i < aig->num_inputs; i++)
+    var[aiger_lit2var(aig->inputs[i].lit)] = ++num_vars;
+  for (unsigned i = 0; i < aig->num_ands; i++)
+    var[aiger_lit2var(aig->ands[i].lhs)] = ++num_vars;
+
+  bool uses_constant = false;
+  for (unsigned i = 0; i < aig->num_ands && !uses_constant; i++)
+    uses_constant = aiger_strip(aig->ands[i].rhs0) == aiger_false ||
+      aiger_strip(aig->ands[i].rhs1) == aiger_false;
+  for (unsigned i = 0; i < aig->num_outputs && !uses_constant; i++)
+    uses_constant = aiger_strip(aig->outputs[i].lit) == aiger_false;
+  if (uses_constant) var[0] = ++num_vars;
+
+  auto lit = [&var](unsigned l) {
+    int64_t res = var[aiger_lit2var(l)];
+    assert(res);
+    return aiger_sign(l) ? -res : res;
+  };
+
+  uint64_t num_clauses = 3ull * aig->num_ands + uses_constant + cnf_assert;
+  out.buffer += "p cnf ";
+  out.put_int(num_vars);
+  out.buffer.push_back(' ');
+  out.put_int(num_clauses);
+  out.buffer.push_back('\n');
+
+  if (uses_constant) put_clause(out, { -var[0] });
+  for (unsigned i = 0; i < aig->num_ands; i++) {
+    const aiger_and * and_node = aig->ands + i;
+    int64_t lhs = lit(and_node->lhs);
+    int64_t rhs0 = lit(and_node->rhs0), rhs1 = lit(and_node->rhs1);
+    put_clause(out, { -lhs, rhs0 });
+    put_clause(out, { -lhs, rhs1 });
+    put_clause(out, { lhs, -rhs0, -rhs1 });
+  }
+  if (cnf_assert) {
+    for (unsigned i = 0; i < aig->num_outputs; i++) {
+      out.put_int(lit(aig->outputs[i].lit));
+      out.buffer.push_back(' ');
+    }
+    out.buffer += "0\n";
+  }
+}
+/*------------------------------------------------------------------------*/
+
+void write_cnf_to_buffer(aiger * aig, std::string & buffer) {
+  buffer.clear();
+  buffered_writer out = { buffer, 0, 0 };
+  encode_aiger(aig, out);
+}
+/*------------------------------------------------------------------------*/
+
+void write_fuzzed_cnf(const char * output_name) {
+  FILE * output_file = open_output_file(output_name);
+
+  std::string buffer;
+  buffer.reserve(WRITER_BUFFER_SIZE + 64);
+  buffered_writer out = { buffer, output_file, output_name };
+  encode_aiger(model, out);
+  out.flush();
+  if (!close_output_file(output_file)) die("failed to write CNF to '%s'", output_name);
+
+  msg("Output");
+  msg("==========================================================");
+  msg("  Printed fuzzed CNF to: '%s'", output_name);
+  msg("");
+}
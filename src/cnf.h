@@ -0,0 +1,40 @@
+/*------------------------------------------------------------------------*/
+/*! \file cnf.h
+    \brief contains the Tseitin encoding of the AIG in DIMACS CNF
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_CNF_H_
+#define AIGENFUZZER_SRC_CNF_H_
+/*------------------------------------------------------------------------*/
+#include <string>
+#include "parser.h"
+/*------------------------------------------------------------------------*/
+
+extern bool cnf_output;   // /< mutants are written in DIMACS CNF
+extern bool cnf_assert;   // /< add a clause asserting that an output is 1
+
+/**
+    Encodes the combinational 'aig' in DIMACS CNF by the Tseitin
+    transformation in linear time. The inputs are the variables 1 to I in
+    their order, followed by the AND gates, each encoded by three clauses.
+    A constant used by 'aig' gets a variable fixed by a unit clause.
+    If 'cnf_assert' is set, the clause (o1 | ... | oO) of the outputs is
+    added, e.g., the unit clause of the bad state of a single output.
+
+    @param aig aiger*, e.g. 'aiger* model'
+    @param buffer std::string, previous content is discarded
+*/
+void write_cnf_to_buffer(aiger * aig, std::string & buffer);
+
+/**
+    Writes the DIMACS CNF of 'aiger* model' to the file 'output_name'
+    through a fixed-size buffer, without keeping the whole CNF in memory.
+
+    @param output_name name of the output file
+*/
+void write_fuzzed_cnf(const char * output_name);
+
+#endif  // AIGENFUZZER_SRC_CNF_H_
@@ -0,0 +1,137 @@
+/*------------------------------------------------------------------------*/
+/*! \file coverage.cpp
+    \brief contains the shared memory edge bitmaps of instrumented tools
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "coverage.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+/*------------------------------------------------------------------------*/
+// Global Variables
+bool collect_coverage = false;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+static unsigned char virgin_bits[COVERAGE_MAP_SIZE];  // /< uncovered buckets
+static unsigned char count_class[256];   // /< hit count to bucket
+static unsigned edges;                   // /< number of covered edges
+
+/*------------------------------------------------------------------------*/
+
+coverage_map create_coverage_map() {
+  coverage_map map;
+  map.shm_id = shmget(IPC_PRIVATE, COVERAGE_MAP_SIZE, IPC_CREAT | IPC_EXCL | 0600);
+  if (map.shm_id < 0) die("failed to create shared memory for coverage");
+
+  void * bits = shmat(map.shm_id, 0, 0);
+  if (bits == reinterpret_cast<void*>(-1))
+    die("failed to attach shared memory for coverage");
+
+  // removed as soon as all processes detached
+  shmctl(map.shm_id, IPC_RMID, 0);
+
+  map.bits = static_cast<unsigned char*>(bits);
+  memset(map.bits, 0, COVERAGE_MAP_SIZE);
+  return map;
+}
+/*------------------------------------------------------------------------*/
+
+void delete_coverage_map(coverage_map & map) {
+  if (!map.bits) return;
+  shmdt(map.bits);
+  map.bits = 0;
+}
+/*------------------------------------------------------------------------*/
+
+void export_coverage_map(const coverage_map & map) {
+  char buffer[32];
+  snprintf(buffer, sizeof buffer, "%d", map.shm_id);
+  setenv(COVERAGE_SHM_ENV, buffer, 1);
+}
+/*------------------------------------------------------------------------*/
+
+void init_coverage() {
+  memset(virgin_bits, 0xff, sizeof virgin_bits);
+  edges = 0;
+
+  count_class[0] = 0;
+  count_class[1] = 1;
+  count_class[2] = 2;
+  count_class[3] = 4;
+  for (unsigned i = 4; i < 8; i++)     count_class[i] = 8;
+  for (unsigned i = 8; i < 16; i++)    count_class[i] = 16;
+  for (unsigned i = 16; i < 32; i++)   count_class[i] = 32;
+  for (unsigned i = 32; i < 128; i++)  count_class[i] = 64;
+  for (unsigned i = 128; i < 256; i++) count_class[i] = 128;
+}
+/*------------------------------------------------------------------------*/
+
+int has_new_coverage(unsigned char * bits) {
+  int res = 0;
+  const uint64_t * words = reinterpret_cast<const uint64_t*>(bits);
+  for (unsigned i = 0; i < COVERAGE_MAP_SIZE; i++) {
+    // most of the map is empty, thus skip zero words
+    if (!(i & 7) && !words[i >> 3]) { i += 7; continue; }
+    if (!bits[i]) continue;
+    unsigned char bucket = count_class[bits[i]];
+    bits[i] = bucket;
+    if (!(bucket & virgin_bits[i])) continue;
+    if (virgin_bits[i] == 0xff) { res = 2; edges++; }
+    else if (!res) res = 1;
+    virgin_bits[i] &= ~bucket;
+  }
+  return res;
+}
+/*------------------------------------------------------------------------*/
+
+void classify_counts(unsigned char * bits) {
+  const uint64_t * words = reinterpret_cast<const uint64_t*>(bits);
+  for (unsigned i = 0; i < COVERAGE_MAP_SIZE; i++) {
+    if (!(i & 7) && !words[i >> 3]) { i += 7; continue; }
+    bits[i] = count_class[bits[i]];
+  }
+}
+/*------------------------------------------------------------------------*/
+
+unsigned covered_edges() { return edges; }
+
+/*------------------------------------------------------------------------*/
+
+unsigned count_edges(const unsigned char * bits) {
+  unsigned res = 0;
+  for (unsigned i = 0; i < COVERAGE_MAP_SIZE; i++)
+    if (bits[i]) res++;
+  return res;
+}
+/*------------------------------------------------------------------------*/
+
+void save_coverage(const char * path) {
+  FILE * file = fopen(path, "w");
+  if (!file || fwrite(virgin_bits, 1, COVERAGE_MAP_SIZE, file) !=
+      COVERAGE_MAP_SIZE)
+    die("can not write coverage to '%s'", path);
+  fclose(file);
+}
+/*------------------------------------------------------------------------*/
+
+bool load_coverage(const char * path) {
+  FILE * file = fopen(path, "r");
+  if (!file) return false;
+  bool res = fread(virgin_bits, 1, COVERAGE_MAP_SIZE, file) ==
+    COVERAGE_MAP_SIZE;
+  fclose(file);
+
+  edges = 0;
+  for (unsigned i = 0; i < COVERAGE_MAP_SIZE; i++)
+    if (virgin_bits[i] != 0xff) edges++;
+  return res;
+}
@@ -0,0 +1,94 @@
+/*------------------------------------------------------------------------*/
+/*! \file coverage.h
+    \brief contains the shared memory edge bitmaps of instrumented tools
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_COVERAGE_H_
+#define AIGENFUZZER_SRC_COVERAGE_H_
+/*------------------------------------------------------------------------*/
+#include <stddef.h>
+
+#include "signal_statistics.h"
+/*------------------------------------------------------------------------*/
+
+#define COVERAGE_MAP_SIZE (1 << 16)   // /< size of the AFL edge bitmap
+#define COVERAGE_SHM_ENV "__AFL_SHM_ID"  // /< passes the map to the tool
+
+/**
+    An edge bitmap in System V shared memory, which is attached by the
+    instrumented tool via the environment variable '__AFL_SHM_ID'.
+*/
+struct coverage_map {
+  int shm_id;            // /< id of the shared memory segment
+  unsigned char * bits;  // /< attached bitmap of size COVERAGE_MAP_SIZE
+};
+
+extern bool collect_coverage;   // /< tools are instrumented for coverage
+
+/**
+    Creates and attaches a new shared memory edge bitmap
+*/
+coverage_map create_coverage_map();
+
+/**
+    Detaches and removes the shared memory edge bitmap
+*/
+void delete_coverage_map(coverage_map & map);
+
+/**
+    Sets the environment variable of the current process to the given map,
+    only called in the child before exec.
+*/
+void export_coverage_map(const coverage_map & map);
+
+/**
+    Initializes the map of edges that have not been covered yet
+*/
+void init_coverage();
+
+/**
+    Compares the edge bitmap of a tool run against the edges covered so far.
+    Hit counts are classified into the buckets 1, 2, 3, 4-7, 8-15, 16-31,
+    32-127 and 128-255 as in AFL. The covered edges are updated.
+
+    @param bits edge bitmap of size COVERAGE_MAP_SIZE
+
+    @return 2 if a new edge is covered, 1 if an edge reached a new hit count
+            bucket, 0 otherwise
+*/
+int has_new_coverage(unsigned char * bits);
+
+/**
+    Classifies the hit counts of an edge bitmap into the buckets of
+    'has_new_coverage', without updating the covered edges.
+
+    @param bits edge bitmap of size COVERAGE_MAP_SIZE
+*/
+void classify_counts(unsigned char * bits);
+
+/**
+    Returns the number of edges covered so far
+*/
+unsigned covered_edges();
+
+/**
+    Returns the number of edges covered by the given classified bitmap
+*/
+unsigned count_edges(const unsigned char * bits);
+
+/**
+    Writes the map of uncovered edges to the file 'path'
+*/
+void save_coverage(const char * path);
+
+/**
+    Restores the map of uncovered edges from the file 'path'
+
+    @return false if the file can not be read
+*/
+bool load_coverage(const char * path);
+
+#endif  // AIGENFUZZER_SRC_COVERAGE_H_
@@ -0,0 +1,156 @@
+/*------------------------------------------------------------------------*/
+/*! \file dedup.cpp
+    \brief contains the structural hash used to detect duplicate mutants
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "dedup.h"
+
+#include <stdio.h>
+
+#include <unordered_set>
+#include <vector>
+/*------------------------------------------------------------------------*/
+// Global Variables
+uint64_t model_hash = 0;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+static std::unordered_set<uint64_t> mutant_hashes;   // /< seen mutants
+
+// tags separating the kinds of terms of the hash
+#define TAG_HEADER 0x68656164ull
+#define TAG_INPUT  0x696e7075ull
+#define TAG_LATCH  0x6c617463ull
+#define TAG_AND    0x616e6420ull
+#define TAG_OUTPUT 0x6f757470ull
+
+/*------------------------------------------------------------------------*/
+/**
+    Finalizer of splitmix64, a bijection with good avalanche behaviour
+*/
+static uint64_t mix(uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Hash of a term consisting of a tag and three literals
+*/
+static uint64_t hash_term(uint64_t tag, unsigned a, unsigned b, unsigned c) {
+  uint64_t res = mix(tag * 0x9e3779b97f4a7c15ull + a);
+  res = mix(res + (static_cast<uint64_t>(b) << 32 | c));
+  return res;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Hash of an AND gate, the inputs are normalized by their order
+*/
+static uint64_t hash_and(const aiger_and * and_node) {
+  unsigned rhs0 = and_node->rhs0, rhs1 = and_node->rhs1;
+  if (rhs0 < rhs1) { unsigned tmp = rhs0; rhs0 = rhs1; rhs1 = tmp; }
+  return hash_term(TAG_AND, and_node->lhs, rhs0, rhs1);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Hash of an output, outputs are distinguished by their index
+*/
+static uint64_t hash_output(unsigned idx, unsigned lit) {
+  return hash_term(TAG_OUTPUT, idx, lit, 0);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Hash of a latch with its next state function and reset value
+*/
+static uint64_t hash_latch(const aiger_symbol * latch) {
+  return hash_term(TAG_LATCH, latch->lit, latch->next, latch->reset);
+}
+/*------------------------------------------------------------------------*/
+
+uint64_t hash_aiger(const aiger * aig) {
+  assert(aig);
+  uint64_t res = hash_term(TAG_HEADER, aig->maxvar, aig->num_inputs,
+    aig->num_latches);
+  for (unsigned i = 0; i < aig->num_inputs; i++)
+    res += hash_term(TAG_INPUT, aig->inputs[i].lit, 0, 0);
+  for (unsigned i = 0; i < aig->num_latches; i++)
+    res += hash_latch(aig->latches + i);
+  for (unsigned i = 0; i < aig->num_ands; i++) res += hash_and(aig->ands + i);
+  for (unsigned i = 0; i < aig->num_outputs; i++)
+    res += hash_output(i, aig->outputs[i].lit);
+  return res;
+}
+/*------------------------------------------------------------------------*/
+
+void hash_model() {
+  model_hash = hash_aiger(model);
+}
+/*------------------------------------------------------------------------*/
+
+void remove_and_from_hash(const aiger_and * and_node) {
+  model_hash -= hash_and(and_node);
+}
+
+void add_and_to_hash(const aiger_and * and_node) {
+  model_hash += hash_and(and_node);
+}
+/*------------------------------------------------------------------------*/
+
+void remove_output_from_hash(unsigned idx) {
+  assert(idx < model->num_outputs);
+  model_hash -= hash_output(idx, model->outputs[idx].lit);
+}
+
+void add_output_to_hash(unsigned idx) {
+  assert(idx < model->num_outputs);
+  model_hash += hash_output(idx, model->outputs[idx].lit);
+}
+/*------------------------------------------------------------------------*/
+
+void remove_latch_from_hash(unsigned idx) {
+  assert(idx < model->num_latches);
+  model_hash -= hash_latch(model->latches + idx);
+}
+
+void add_latch_to_hash(unsigned idx) {
+  assert(idx < model->num_latches);
+  model_hash += hash_latch(model->latches + idx);
+}
+/*------------------------------------------------------------------------*/
+
+bool insert_mutant_hash(uint64_t hash) {
+  return mutant_hashes.insert(hash).second;
+}
+/*------------------------------------------------------------------------*/
+
+size_t num_mutant_hashes() {
+  return mutant_hashes.size();
+}
+/*------------------------------------------------------------------------*/
+
+void save_mutant_hashes(const char * path) {
+  FILE * file = fopen(path, "wb");
+  if (!file) die("can not write mutant hashes to '%s'", path);
+  std::vector<uint64_t> hashes(mutant_hashes.begin(), mutant_hashes.end());
+  if (fwrite(hashes.data(), sizeof(uint64_t), hashes.size(), file) !=
+      hashes.size() || fclose(file))
+    die("can not write mutant hashes to '%s'", path);
+}
+/*------------------------------------------------------------------------*/
+
+bool load_mutant_hashes(const char * path) {
+  FILE * file = fopen(path, "rb");
+  if (!file) return false;
+  mutant_hashes.clear();
+  uint64_t buffer[512];
+  size_t read;
+  while ((read = fread(buffer, sizeof(uint64_t), 512, file)))
+    mutant_hashes.insert(buffer, buffer + read);
+  bool res = !ferror(file);
+  fclose(file);
+  return res;
+}
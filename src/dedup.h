@@ -0,0 +1,81 @@
+/*------------------------------------------------------------------------*/
+/*! \file dedup.h
+    \brief contains the structural hash used to detect duplicate mutants
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_DEDUP_H_
+#define AIGENFUZZER_SRC_DEDUP_H_
+/*------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "parser.h"
+/*------------------------------------------------------------------------*/
+
+extern uint64_t model_hash;   // /< structural hash of 'aiger* model'
+
+/**
+    Computes the structural hash of an AIG. The hash is the sum of the
+    hashes of the inputs, latches, AND gates and outputs, and thus does not
+    depend on the order of the AND gates or of the inputs of an AND gate.
+    Names and comments are ignored.
+
+    @param aig aiger*
+*/
+uint64_t hash_aiger(const aiger * aig);
+
+/**
+    Recomputes 'model_hash' from scratch, e.g., after 'aiger* model' has
+    been reencoded
+*/
+void hash_model();
+
+/**
+    Updates 'model_hash' before and after an AND gate of 'aiger* model' is
+    modified in place, such that the hash of a mutant is derived from the
+    hash of its base in constant time per modification.
+*/
+void remove_and_from_hash(const aiger_and * and_node);
+void add_and_to_hash(const aiger_and * and_node);
+
+/**
+    Updates 'model_hash' before and after the output with index 'idx' of
+    'aiger* model' is modified in place.
+*/
+void remove_output_from_hash(unsigned idx);
+void add_output_to_hash(unsigned idx);
+
+/**
+    Updates 'model_hash' before and after the latch with index 'idx' of
+    'aiger* model' is modified in place.
+*/
+void remove_latch_from_hash(unsigned idx);
+void add_latch_to_hash(unsigned idx);
+
+/**
+    Records the hash of a mutant.
+
+    @param hash structural hash of the mutant
+    @return false if the hash was recorded before
+*/
+bool insert_mutant_hash(uint64_t hash);
+
+/**
+    Returns the number of recorded hashes
+*/
+size_t num_mutant_hashes();
+
+/**
+    Writes the recorded hashes to the binary file 'path'
+*/
+void save_mutant_hashes(const char * path);
+
+/**
+    Replaces the recorded hashes by the ones in the binary file 'path'
+
+    @return false if the file can not be read
+*/
+bool load_mutant_hashes(const char * path);
+
+#endif  // AIGENFUZZER_SRC_DEDUP_H_
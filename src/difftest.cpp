@@ -0,0 +1,658 @@
+/*------------------------------------------------------------------------*/
+/*! \file difftest.cpp
+    \brief contains the differential testing of several tools on mutants
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "difftest.h"
+
+#include <stdio.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <list>
+#include <set>
+
+#include "campaign.h"
+#include "cnf.h"
+#include "dedup.h"
+#include "level.h"
+#include "poly.h"
+#include "scheduler.h"
+#include "target.h"
+#include "triage.h"
+/*------------------------------------------------------------------------*/
+// Global Variables
+std::vector<tool> tools;
+unsigned num_mutants = 100;
+const char * results_dir = "aigofuzzing-results";
+int perf_metric = PERF_NONE;
+unsigned max_ands = 0;
+bool resume_campaign = false;
+double checkpoint_interval = 300;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+/**
+    A generated mutant, which is kept until all tools terminated on it
+*/
+struct test_mutant {
+  unsigned seed;                 // /< seed used to generate the mutant
+  unsigned parent;               // /< queue entry the mutant is derived from
+  unsigned donor;                // /< queue entry used for crossover
+  std::string path;              // /< temporary file of the mutant
+  std::string aig;               // /< binary AIGER encoding of the mutant
+  std::string input;             // /< CNF or polynomials for the tools
+  unsigned next_tool;            // /< index of the next tool to start
+  unsigned finished;             // /< number of terminated tools
+  std::vector<tool_run> runs;    // /< results indexed by tools
+  bool new_coverage;             // /< a tool reached new coverage
+  unsigned edges;                // /< maximum number of edges of a tool
+  unsigned maxvar;               // /< maximum variable index of the mutant
+  unsigned ands;                 // /< number of AND gates of the mutant
+  double cost;                   // /< maximum cost of a tool
+  int op;                        // /< operator chosen by the scheduler, or 0
+  double cpu_time;               // /< CPU time of all tools
+};
+
+static std::list<test_mutant> mutants;   // /< mutants in flight
+
+/**
+    A mutant that was in flight when the checkpoint was written
+*/
+struct pending_mutant {
+  unsigned seed;     // /< seed of the mutant
+  unsigned parent;   // /< queue entry the mutant is derived from
+  unsigned donor;    // /< queue entry used for crossover
+  int op;            // /< operator of the mutant
+};
+
+static std::list<pending_mutant> resumed;   // /< regenerated first
+
+#define CHECKPOINT_VERSION 6
+
+static FILE * log_file;
+static const char * log_input_name;
+
+static unsigned first_seed;     // /< seed of the first mutant
+static unsigned generated, tested, duplicates, tool_runs;
+static uint64_t base_hash;      // /< structural hash of the input
+static unsigned disagreements, crashes, timeouts;
+static double max_fitness;      // /< highest cost per variable so far
+
+// a new maximum of the CPU time has to exceed the old one by 5% to ignore
+// measurement noise, the maximum resident set size is exact enough
+static const double min_time_gain = 1.05;
+
+/*------------------------------------------------------------------------*/
+/**
+    Returns true if mutants are derived from the queue of a campaign
+*/
+static bool use_queue() { return collect_coverage || perf_metric; }
+
+/*------------------------------------------------------------------------*/
+/**
+    Returns the encoding of the mutant given to the tools, which is DIMACS
+    CNF with '--cnf' and polynomials with '--poly', while the stored
+    mutants are always AIGs
+*/
+static const std::string & tool_input(const test_mutant & mutant) {
+  return cnf_output || poly_output ? mutant.input : mutant.aig;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Generates the mutant with the given seed, parent, donor and operator,
+    writes it to the temporary directory and appends it to the mutants in
+    flight.
+    Mutants with the structural hash of an earlier mutant or of the input
+    are counted as duplicates and dropped, unless 'resumed' is set, since
+    mutants in flight were recorded before the checkpoint was written.
+*/
+static void generate_test_mutant(unsigned seed, unsigned parent,
+  unsigned donor, int op, bool resumed) {
+  fuzz_operator = op;
+  if (use_queue()) {
+    // the donor is owned by the queue
+    donor_model = campaign_queue[donor].aig;
+    generate_mutant(campaign_queue[parent].aig, campaign_queue[parent].hash,
+      seed);
+    donor_model = 0;
+  } else {
+    generate_mutant(base_model, base_hash, seed);
+  }
+
+  if (!insert_mutant_hash(model_hash) && !resumed) {
+    duplicates++;
+    return;
+  }
+
+  mutants.emplace_back();
+  test_mutant & mutant = mutants.back();
+  mutant.seed = seed;
+  mutant.parent = parent;
+  mutant.donor = donor;
+  mutant.next_tool = mutant.finished = 0;
+  mutant.runs.resize(tools.size());
+  mutant.new_coverage = false;
+  mutant.edges = 0;
+  mutant.maxvar = model->maxvar;
+  mutant.ands = model->num_ands;
+  mutant.cost = 0;
+  mutant.op = fuzz_operator;
+  mutant.cpu_time = 0;
+  write_model_to_buffer(mutant.aig);
+  if (cnf_output) write_cnf_to_buffer(model, mutant.input);
+  else if (poly_output) write_poly_to_buffer(model, mutant.input);
+
+  // fork servers copy the mutant to their own input file
+  if (use_forkserver) return;
+
+  char path[4096];
+  snprintf(path, sizeof path, "%s/agf-%d-%u.%s",
+    temporary_directory(), getpid(), seed,
+    cnf_output ? "cnf" : poly_output ? "poly" : "aig");
+  mutant.path = path;
+  write_buffer_to_file(path, tool_input(mutant));
+}
+/*------------------------------------------------------------------------*/
+/**
+    Generates the next mutant. Mutants that were in flight when the resumed
+    checkpoint was written come first. In a coverage-guided campaign the
+    mutant is derived from the next queue entry, and another queue entry
+    is the donor for crossover.
+*/
+static void generate_next_test_mutant() {
+  if (!resumed.empty()) {
+    pending_mutant pending = resumed.front();
+    resumed.pop_front();
+    generate_test_mutant(pending.seed, pending.parent, pending.donor,
+      pending.op, true);
+    return;
+  }
+
+  unsigned parent = 0, donor = 0;
+  if (perf_metric) parent = select_fittest_queue_entry();
+  else if (collect_coverage) parent = select_queue_entry();
+  if (use_queue()) donor = select_donor_queue_entry(parent);
+  int op = adaptive_scheduling ? select_operator() : fuzz_operator;
+  generate_test_mutant(first_seed + generated++, parent, donor, op, false);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Starts the next tool on the oldest mutant that has not been handed to
+    all tools yet.
+
+    @return false if all tools are started on all mutants in flight
+*/
+static bool start_next_tool_run() {
+  for (test_mutant & mutant : mutants) {
+    if (mutant.next_tool == tools.size()) continue;
+    unsigned idx = mutant.next_tool++;
+    execute_tool(tools[idx], idx, mutant.path.c_str(), tool_input(mutant),
+      mutant.seed);
+    tool_runs++;
+    return true;
+  }
+  return false;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Returns the number of mutants in flight that wait for a tool
+*/
+static unsigned waiting_mutants() {
+  unsigned res = 0;
+  for (const test_mutant & mutant : mutants)
+    if (mutant.next_tool < tools.size()) res++;
+  return res;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Appends the command line reproducing the mutant and the verdicts of
+    all tools to the log.
+*/
+static void log_mutant(const test_mutant & mutant) {
+  const char * base_name = use_queue() ?
+    campaign_queue[mutant.parent].path.c_str() : log_input_name;
+
+  fprintf(log_file, "  reproduce: aigofuzzing %s out.aig -s %u -m %d",
+    base_name, mutant.seed, modifications);
+  if (mutant.op) fprintf(log_file, " -o %d", mutant.op);
+  else if (technique) fprintf(log_file, " -t %d", technique);
+  if (use_queue())
+    fprintf(log_file, " --donor %s", campaign_queue[mutant.donor].path.c_str());
+  else if (donor_name) fprintf(log_file, " --donor %s", donor_name);
+  if (target_metric)
+    fprintf(log_file, " --target %s", target_metric_name());
+  if (max_depth) fprintf(log_file, " --max-depth %u", max_depth);
+  if (strash_mutant) fprintf(log_file, " --strash");
+  if (prune_mutant) fprintf(log_file, " --coi");
+  fputc('\n', log_file);
+  for (unsigned i = 0; i < tools.size(); i++) {
+    const tool_run & run = mutant.runs[i];
+    fprintf(log_file, "  %-12s %7.2f s  %s\n",
+      describe_tool_run(run).c_str(), run.wall_time, tools[i].command.c_str());
+  }
+  fflush(log_file);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Stores the mutant as '<kind>-<seed>.aig' in the results directory and
+    appends it to the log.
+*/
+static void report_mutant(const test_mutant & mutant, const char * kind) {
+  char path[4096];
+  snprintf(path, sizeof path, "%s/%s-%u.aig", results_dir, kind, mutant.seed);
+  write_buffer_to_file(path, mutant.aig);
+
+  fprintf(log_file, "%s seed %u file %s\n", kind, mutant.seed, path);
+  log_mutant(mutant);
+
+  msg("  %-13s seed %u", kind, mutant.seed);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Adds a failing mutant to the bucket of its signature. Only the first
+    and smaller representatives of a bucket are stored as
+    '<kind>-<hash>.aig' and logged, duplicates are just counted.
+
+    @return true if a new bucket was created
+*/
+static bool report_failure(const test_mutant & mutant, const char * kind,
+  const std::string & signature) {
+  bool replaced;
+  unsigned idx = add_to_bucket(kind, signature, mutant.seed, mutant.ands,
+    mutant.aig.size(), replaced);
+  if (!replaced) return false;
+
+  failure_bucket & bucket = buckets[idx];
+  bool is_new = bucket.path.empty();
+  if (is_new) {
+    char path[4096];
+    snprintf(path, sizeof path, "%s/%s-%016llx.aig", results_dir, kind,
+      static_cast<unsigned long long>(bucket.hash));
+    bucket.path = path;
+  }
+  write_buffer_to_file(bucket.path.c_str(), mutant.aig);
+
+  fprintf(log_file, "%s bucket %016llx seed %u, %u ands, file %s\n", kind,
+    static_cast<unsigned long long>(bucket.hash), mutant.seed, mutant.ands,
+    is_new ? bucket.path.c_str() : "replaced by smaller mutant");
+  if (is_new) fprintf(log_file, "  signature: %s\n", signature.c_str());
+  log_mutant(mutant);
+
+  if (is_new) msg("  new bucket    %s seed %u: %s", kind, mutant.seed,
+    signature.c_str());
+  return is_new;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Compares the verdicts of all tools on a mutant and records crashes,
+    timeouts and disagreements of the exit codes. A tool crashes if it is
+    killed by a signal or reports a sanitizer error on stderr.
+*/
+static void evaluate_mutant(const test_mutant & mutant) {
+  std::string crash, timeout, disagreement;
+  std::set<int> verdicts;
+
+  for (unsigned i = 0; i < tools.size(); i++) {
+    const tool_run & run = mutant.runs[i];
+    const char * kind = 0;
+    if (run.timeout) kind = "timeout";
+    else if (WIFSIGNALED(run.status)) kind = "crash";
+    else if (WEXITSTATUS(run.status) == 127)
+      die("tool '%s' could not be executed", tools[i].command.c_str());
+    else if (has_sanitizer_report(run.error_output)) kind = "crash";
+    else verdicts.insert(WEXITSTATUS(run.status));
+
+    if (!kind) continue;
+    std::string & signature = run.timeout ? timeout : crash;
+    if (!signature.empty()) signature += "; ";
+    signature += fingerprint_tool_run(kind, i, run);
+  }
+
+  if (verdicts.size() > 1) {
+    // the pattern of the exit codes tells which tool disagrees
+    disagreement = "exit codes";
+    for (unsigned i = 0; i < tools.size(); i++) {
+      const tool_run & run = mutant.runs[i];
+      if (run.timeout || WIFSIGNALED(run.status) ||
+          has_sanitizer_report(run.error_output)) disagreement += " -";
+      else disagreement += " " + std::to_string(WEXITSTATUS(run.status));
+    }
+  }
+
+  bool new_bucket = false;
+  if (!crash.empty()) {
+    crashes++;
+    new_bucket |= report_failure(mutant, "crash", crash);
+  }
+  if (!timeout.empty()) {
+    timeouts++;
+    new_bucket |= report_failure(mutant, "timeout", timeout);
+  }
+  if (!disagreement.empty()) {
+    disagreements++;
+    new_bucket |= report_failure(mutant, "disagreement", disagreement);
+  }
+
+  double fitness = 0;
+  if (perf_metric && timeout.empty() && mutant.ands <= max_ands) {
+    fitness = mutant.cost / (mutant.maxvar + 1);
+    double gain = perf_metric == PERF_TIME ? min_time_gain : 1;
+    if (fitness > gain * max_fitness) {
+      max_fitness = fitness;
+      report_mutant(mutant, "slow");
+      if (perf_metric == PERF_TIME)
+        msg("  new maximum   seed %u, %.3f s, %.2f us per variable",
+          mutant.seed, mutant.cost, 1e6 * fitness);
+      else
+        msg("  new maximum   seed %u, %.1f MB, %.2f KB per variable",
+          mutant.seed, mutant.cost, 1024 * fitness);
+    } else {
+      fitness = 0;
+    }
+  }
+
+  if (adaptive_scheduling)
+    update_scheduler(mutant.op, mutant.cpu_time,
+      new_bucket || mutant.new_coverage || fitness > 0);
+
+  if (mutant.new_coverage || fitness > 0)
+    add_queue_entry(mutant.aig, mutant.parent, mutant.seed, mutant.edges,
+      fitness);
+  if (mutant.new_coverage)
+    msg("  new coverage  seed %u, queue %zu, edges %u",
+      mutant.seed, campaign_queue.size(), covered_edges());
+  tested++;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Stores the result of a terminated tool, and evaluates and removes the
+    mutant once all tools terminated on it. The edge bitmap of the tool is
+    only valid here, thus it is compared to the coverage immediately.
+*/
+static void handle_tool_run(const tool_run & run) {
+  for (auto it = mutants.begin(); it != mutants.end(); ++it) {
+    if (it->seed != run.job) continue;
+    it->runs[run.tool_idx] = run;
+    it->runs[run.tool_idx].trace_bits = 0;
+
+    if (run.trace_bits && !run.timeout && has_new_coverage(run.trace_bits)) {
+      it->new_coverage = true;
+      unsigned edges = count_edges(run.trace_bits);
+      if (edges > it->edges) it->edges = edges;
+    }
+
+    double cost = perf_metric == PERF_TIME ? run.cpu_time :
+      run.max_rss / (double) (1 << 20);
+    if (cost > it->cost) it->cost = cost;
+    // fork servers do not provide the CPU time of their children
+    it->cpu_time += run.forkserver >= 0 ? run.wall_time : run.cpu_time;
+
+    if (++it->finished < tools.size()) return;
+    evaluate_mutant(*it);
+    if (!it->path.empty()) unlink(it->path.c_str());
+    mutants.erase(it);
+    return;
+  }
+  assert(0);
+}
+/*------------------------------------------------------------------------*/
+
+/**
+    Returns the file name of the checkpoint in the results directory
+*/
+static std::string checkpoint_path(const char * name) {
+  return std::string(results_dir) + "/" + name;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Writes the state of the campaign to 'checkpoint' in the results
+    directory: the counters, the random state of the scheduling decisions,
+    the mutants in flight, the queue, the scheduler and the buckets. The
+    hashes of the generated mutants are written to 'checkpoint-mutants' and
+    the covered edges to 'checkpoint-coverage'. All files are replaced
+    atomically.
+
+    @param elapsed wall clock time of the campaign so far
+*/
+static void save_checkpoint(double elapsed) {
+  std::string path = checkpoint_path("checkpoint");
+  std::string tmp = path + ".tmp";
+  FILE * file = fopen(tmp.c_str(), "w");
+  if (!file) die("can not write checkpoint to '%s'", tmp.c_str());
+
+  fprintf(file, "aigofuzzing checkpoint %d\n", CHECKPOINT_VERSION);
+  fprintf(file, "mode %d %d %d\n", collect_coverage, perf_metric,
+    adaptive_scheduling);
+  fprintf(file, "seed %u\n", first_seed);
+  fprintf(file, "tools %zu\n", tools.size());
+  for (const tool & t : tools) fprintf(file, "%s\n", t.command.c_str());
+  fprintf(file, "mutants %u %u %u %u %u %u %u\n", generated, tested,
+    duplicates, tool_runs, disagreements, crashes, timeouts);
+  fprintf(file, "elapsed %.17g\n", elapsed);
+  fprintf(file, "fitness %.17g\n", max_fitness);
+  fprintf(file, "rng %llu\n", static_cast<unsigned long long>(campaign_rng));
+
+  fprintf(file, "pending %zu\n", mutants.size() + resumed.size());
+  for (const test_mutant & mutant : mutants)
+    fprintf(file, "%u %u %u %d\n", mutant.seed, mutant.parent, mutant.donor,
+      mutant.op);
+  for (const pending_mutant & pending : resumed)
+    fprintf(file, "%u %u %u %d\n", pending.seed, pending.parent,
+      pending.donor, pending.op);
+
+  if (use_queue()) save_queue(file);
+  if (adaptive_scheduling) save_scheduler(file);
+  save_buckets(file);
+  if (fclose(file)) die("can not write checkpoint to '%s'", tmp.c_str());
+
+  std::string hashes = checkpoint_path("checkpoint-mutants");
+  save_mutant_hashes((hashes + ".tmp").c_str());
+  if (rename((hashes + ".tmp").c_str(), hashes.c_str()))
+    die("can not write checkpoint to '%s'", hashes.c_str());
+
+  if (collect_coverage) {
+    std::string coverage = checkpoint_path("checkpoint-coverage");
+    save_coverage((coverage + ".tmp").c_str());
+    if (rename((coverage + ".tmp").c_str(), coverage.c_str()))
+      die("can not write checkpoint to '%s'", coverage.c_str());
+  }
+  if (rename(tmp.c_str(), path.c_str()))
+    die("can not write checkpoint to '%s'", path.c_str());
+}
+/*------------------------------------------------------------------------*/
+/**
+    Restores the state of the campaign written by 'save_checkpoint'. The
+    checkpoint has to be written by a campaign with the same mode and tools.
+
+    @return wall clock time of the campaign so far
+*/
+static double load_checkpoint() {
+  std::string path = checkpoint_path("checkpoint");
+  FILE * file = fopen(path.c_str(), "r");
+  if (!file) die("can not read checkpoint '%s' to resume", path.c_str());
+
+  int version, coverage, perf, adaptive;
+  size_t num_tools, num_pending;
+  unsigned long long rng;
+  double elapsed;
+  std::string line;
+
+  if (fscanf(file, "aigofuzzing checkpoint %d", &version) != 1 ||
+      version != CHECKPOINT_VERSION)
+    die("'%s' is not a checkpoint of this version", path.c_str());
+  if (fscanf(file, " mode %d %d %d", &coverage, &perf, &adaptive) != 3 ||
+      fscanf(file, " seed %u", &first_seed) != 1 ||
+      fscanf(file, " tools %zu", &num_tools) != 1 || !read_line(file, line))
+    die("malformed checkpoint '%s'", path.c_str());
+  if (coverage != collect_coverage || perf != perf_metric ||
+      adaptive != adaptive_scheduling)
+    die("checkpoint '%s' was written in a different mode", path.c_str());
+  if (num_tools != tools.size())
+    die("checkpoint '%s' was written for different tools", path.c_str());
+  for (const tool & t : tools)
+    if (!read_line(file, line) || line != t.command)
+      die("checkpoint '%s' was written for different tools", path.c_str());
+
+  if (fscanf(file, " mutants %u %u %u %u %u %u %u", &generated, &tested,
+        &duplicates, &tool_runs, &disagreements, &crashes, &timeouts) != 7 ||
+      fscanf(file, " elapsed %lg", &elapsed) != 1 ||
+      fscanf(file, " fitness %lg", &max_fitness) != 1 ||
+      fscanf(file, " rng %llu", &rng) != 1 ||
+      fscanf(file, " pending %zu", &num_pending) != 1)
+    die("malformed checkpoint '%s'", path.c_str());
+  campaign_rng = rng;
+
+  resumed.clear();
+  for (size_t i = 0; i < num_pending; i++) {
+    pending_mutant pending;
+    if (fscanf(file, "%u %u %u %d", &pending.seed, &pending.parent,
+        &pending.donor, &pending.op) != 4)
+      die("malformed checkpoint '%s'", path.c_str());
+    resumed.push_back(pending);
+  }
+
+  if ((use_queue() && !load_queue(file)) ||
+      (adaptive_scheduling && !load_scheduler(file)) || !load_buckets(file))
+    die("malformed checkpoint '%s'", path.c_str());
+  fclose(file);
+
+  std::string hashes_path = checkpoint_path("checkpoint-mutants");
+  if (!load_mutant_hashes(hashes_path.c_str()))
+    die("can not read checkpoint '%s'", hashes_path.c_str());
+
+  std::string coverage_path = checkpoint_path("checkpoint-coverage");
+  if (collect_coverage && !load_coverage(coverage_path.c_str()))
+    die("can not read checkpoint '%s'", coverage_path.c_str());
+
+  return elapsed;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Removes the temporary files of the mutants in flight
+*/
+static void discard_mutants() {
+  for (const test_mutant & mutant : mutants)
+    if (!mutant.path.empty()) unlink(mutant.path.c_str());
+  mutants.clear();
+}
+/*------------------------------------------------------------------------*/
+
+void run_diff_test(const char * input_name, unsigned seed) {
+  if (tools.empty()) die("no tool given for differential testing (try '-h')");
+
+  make_directory(results_dir);
+  char path[4096];
+  snprintf(path, sizeof path, "%s/results.log", results_dir);
+  if (!(log_file = fopen(path, "a"))) die("can not write log to '%s'", path);
+  log_input_name = input_name;
+
+  init_executor();
+  store_base_model();
+  if (collect_coverage) init_coverage();
+  if (use_queue()) init_queue(results_dir);
+  if (perf_metric && !max_ands) max_ands = 2 * base_model->num_ands;
+  if (adaptive_scheduling) init_scheduler();
+  base_hash = hash_aiger(base_model);
+  insert_mutant_hash(base_hash);
+
+  first_seed = seed;
+  campaign_rng = seed;
+  double elapsed = resume_campaign ? load_checkpoint() : 0;
+
+  if (perf_metric) msg("Perf fuzzing campaign");
+  else if (collect_coverage) msg("Coverage-guided campaign");
+  else msg("Differential testing");
+  msg("==========================================================");
+  msg("  Tools:           %zu", tools.size());
+  for (const tool & t : tools) msg("                   '%s'", t.command.c_str());
+  if (num_mutants) msg("  Mutants:         %u", num_mutants);
+  else msg("  Mutants:         unlimited");
+  msg("  Parallel jobs:   %u", max_jobs);
+  msg("  Temporary dir:   '%s'", temporary_directory());
+  msg("  Results dir:     '%s'", results_dir);
+  if (perf_metric) {
+    msg("  Cost:            %s",
+      perf_metric == PERF_TIME ? "CPU time" : "maximum resident set size");
+    msg("  AND gate limit:  %u", max_ands);
+  }
+  if (resume_campaign) {
+    msg("  Resumed:         %u mutants tested, %zu in flight, seed %u",
+      tested, resumed.size(), first_seed);
+  }
+  msg("");
+
+  double start = wall_clock_time() - elapsed;
+  double last_checkpoint = wall_clock_time();
+
+  // SIGINT and SIGTERM stop the campaign and write a checkpoint
+  catch_interrupts = true;
+
+  // Mutants are generated while the tools run, but at most 'max_jobs'
+  // mutants wait for a free slot, which bounds the used temporary space.
+  while (!interrupt_signal &&
+         (!num_mutants || tested + duplicates < num_mutants)) {
+    if (checkpoint_interval > 0 &&
+        wall_clock_time() - last_checkpoint >= checkpoint_interval) {
+      save_checkpoint(wall_clock_time() - start);
+      last_checkpoint = wall_clock_time();
+    }
+
+    while (!executor_full() && start_next_tool_run()) {}
+
+    if ((!num_mutants || generated < num_mutants || !resumed.empty()) &&
+        waiting_mutants() < max_jobs) {
+      quiet = true;
+      generate_next_test_mutant();
+      quiet = false;
+      continue;
+    }
+
+    tool_run run;
+    if (collect_tool_run(run, true)) handle_tool_run(run);
+  }
+
+  elapsed = wall_clock_time() - start;
+  catch_interrupts = false;
+
+  if (interrupt_signal)
+    msg("  caught signal '%s', stopping", signal_name(interrupt_signal));
+  save_checkpoint(elapsed);
+
+  reset_executor();
+  discard_mutants();
+  fclose(log_file);
+  if (!buckets.empty()) write_buckets(results_dir);
+
+  msg("");
+  msg("  tested mutants:  %u", tested);
+  msg("  duplicates:      %u", duplicates);
+  msg("  tool runs:       %u", tool_runs);
+  msg("  disagreements:   %u", disagreements);
+  msg("  crashes:         %u", crashes);
+  msg("  timeouts:        %u", timeouts);
+  msg("  failure buckets: %zu", buckets.size());
+  if (use_queue()) msg("  queue entries:   %zu", campaign_queue.size());
+  if (collect_coverage) msg("  covered edges:   %u", covered_edges());
+  if (perf_metric == PERF_TIME)
+    msg("  maximum cost:    %.2f us per variable", 1e6 * max_fitness);
+  else if (perf_metric == PERF_MEMORY)
+    msg("  maximum cost:    %.2f KB per variable", 1024 * max_fitness);
+  if (use_queue()) reset_queue();
+  msg("  wall clock time: %.2f seconds (%.1f mutants per second)",
+    elapsed, elapsed > 0 ? tested / elapsed : 0);
+  if (!buckets.empty()) {
+    msg("");
+    msg("  kind            mutants  signature");
+    print_buckets();
+  }
+  if (adaptive_scheduling) {
+    msg("");
+    print_scheduler_statistics();
+  }
+  msg("");
+}
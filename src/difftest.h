@@ -0,0 +1,53 @@
+/*------------------------------------------------------------------------*/
+/*! \file difftest.h
+    \brief contains the differential testing of several tools on mutants
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_DIFFTEST_H_
+#define AIGENFUZZER_SRC_DIFFTEST_H_
+/*------------------------------------------------------------------------*/
+#include "executor.h"
+#include "fuzzer.h"
+/*------------------------------------------------------------------------*/
+
+#define PERF_NONE 0      // /< no perf fuzzing
+#define PERF_TIME 1      // /< perf fuzzing for CPU time
+#define PERF_MEMORY 2    // /< perf fuzzing for maximum resident set size
+
+extern std::vector<tool> tools;     // /< tools under test
+extern unsigned num_mutants;        // /< number of generated mutants, 0 = no limit
+extern const char * results_dir;    // /< directory for failing mutants
+extern int perf_metric;             // /< cost maximized by perf fuzzing
+extern unsigned max_ands;           // /< size cap of perf fuzzing, 0 = twice the input
+extern bool resume_campaign;        // /< continue from the checkpoint
+extern double checkpoint_interval;  // /< seconds between checkpoints, 0 = none
+
+/**
+    Generates 'num_mutants' mutants of 'aiger* base_model' with the seeds
+    'seed', 'seed+1', ... and runs all tools on each of them in a bounded
+    process pool. Mutants on which the tools disagree, or on which a tool
+    crashes or times out, are stored in 'results_dir'.
+
+    If 'collect_coverage' is set, the mutants are derived from the queue of
+    the campaign, and mutants reaching new edges are added to the queue.
+    If 'perf_metric' is set, the cost of the tools on a mutant relative to
+    its number of variables is measured, mutants with a new maximum are
+    added to the queue and mutated preferably. Mutants with more than
+    'max_ands' AND gates are not added.
+    If 'adaptive_scheduling' is set, the operator of each mutant is selected
+    by its yield of interesting mutants per CPU-second.
+    If 'num_mutants' is 0 the campaign does not stop.
+    The state is written to a checkpoint in 'results_dir' every
+    'checkpoint_interval' seconds, at the end, and when the campaign is
+    stopped by SIGINT or SIGTERM. If 'resume_campaign' is set, the campaign
+    continues from this checkpoint, and 'seed' is ignored.
+
+    @param input_name name of the input file, used for the log
+    @param seed unsigned integer, seed of the first mutant
+*/
+void run_diff_test(const char * input_name, unsigned seed);
+
+#endif  // AIGENFUZZER_SRC_DIFFTEST_H_
@@ -0,0 +1,528 @@
+/*------------------------------------------------------------------------*/
+/*! \file executor.cpp
+    \brief contains a bounded process pool to execute the tools under test
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "executor.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <sstream>
+/*------------------------------------------------------------------------*/
+// Global Variables
+unsigned max_jobs = 0;
+double time_limit = 0;
+size_t memory_limit = 0;
+const char * tmp_dir = 0;
+bool use_forkserver = false;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+#define FORKSRV_FD 198   // /< control pipe of the fork server, as in AFL
+
+/**
+    A started instance of a tool that waits at its fork server hook and
+    forks a fresh copy of itself for each request.
+*/
+struct forkserver {
+  unsigned tool_idx;        // /< index of the tool
+  pid_t pid;                // /< process id of the fork server
+  int ctl_fd;               // /< write end of the control pipe
+  int st_fd;                // /< read end of the status pipe
+  int input_fd;             // /< input file, shared with the fork server
+  std::string input_path;   // /< name of the input file
+  bool busy;                // /< a forked copy is running
+  coverage_map map;         // /< edge bitmap if coverage is collected
+  int err_fd;               // /< stderr of the fork server and its copies
+};
+
+static std::vector<tool_run> slots;   // /< running tools, pid 0 if unused
+static std::vector<coverage_map> slot_maps;   // /< edge bitmaps of slots
+static std::vector<int> slot_err_fds;         // /< stderr files of slots
+static std::vector<forkserver> forkservers;
+static unsigned running;              // /< number of running tools
+static sigset_t original_mask;        // /< signal mask before init_executor
+static struct sigaction original_SIGCHLD_action;
+static bool initialized;
+
+/*------------------------------------------------------------------------*/
+
+tool parse_tool(const char * command) {
+  tool res;
+  res.command = command;
+  res.uses_file = false;
+
+  std::istringstream stream(command);
+  std::string arg;
+  while (stream >> arg) {
+    if (arg.find("@@") != std::string::npos) res.uses_file = true;
+    res.argv.push_back(arg);
+  }
+  if (res.argv.empty()) die("empty tool command line given");
+
+  return res;
+}
+/*------------------------------------------------------------------------*/
+
+unsigned number_of_cores() {
+  long res = sysconf(_SC_NPROCESSORS_ONLN);
+  return res > 0 ? res : 1;
+}
+/*------------------------------------------------------------------------*/
+
+const char * temporary_directory() {
+  if (tmp_dir) return tmp_dir;
+  if (!access("/dev/shm", W_OK)) return "/dev/shm";
+  return "/tmp";
+}
+/*------------------------------------------------------------------------*/
+/**
+    Empty handler, SIGCHLD only has to interrupt 'ppoll'.
+*/
+static void catch_SIGCHLD(int) {}
+
+/**
+    Creates an anonymous file in the temporary directory that receives
+    the stderr of a tool. It is opened in append mode, thus truncating it
+    rewinds the writing tool as well.
+*/
+static int create_stderr_file() {
+  char path[4096];
+  snprintf(path, sizeof path, "%s/agf-err-%d-XXXXXX",
+    temporary_directory(), getpid());
+  int fd = mkstemp(path);
+  if (fd < 0) die("can not create file '%s'", path);
+  unlink(path);
+  fcntl(fd, F_SETFL, O_APPEND);
+  fcntl(fd, F_SETFD, FD_CLOEXEC);
+  return fd;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Reads the last STDERR_LIMIT bytes of a stderr file.
+*/
+static void read_stderr_file(int fd, std::string & res) {
+  res.clear();
+  off_t size = lseek(fd, 0, SEEK_END);
+  if (size <= 0) return;
+  off_t start = size > STDERR_LIMIT ? size - STDERR_LIMIT : 0;
+  res.resize(size - start);
+  ssize_t bytes = pread(fd, &res[0], res.size(), start);
+  res.resize(bytes > 0 ? bytes : 0);
+}
+/*------------------------------------------------------------------------*/
+
+void init_executor() {
+  assert(!initialized);
+  if (!max_jobs) max_jobs = number_of_cores();
+
+  struct sigaction action;
+  memset(&action, 0, sizeof action);
+  action.sa_handler = catch_SIGCHLD;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGCHLD, &action, &original_SIGCHLD_action);
+
+  sigset_t mask;
+  sigemptyset(&mask);
+  sigaddset(&mask, SIGCHLD);
+  sigprocmask(SIG_BLOCK, &mask, &original_mask);
+
+  slots.assign(max_jobs, tool_run());
+  if (collect_coverage)
+    for (unsigned i = 0; i < max_jobs; i++)
+      slot_maps.push_back(create_coverage_map());
+  for (unsigned i = 0; i < max_jobs; i++)
+    slot_err_fds.push_back(create_stderr_file());
+  running = 0;
+  initialized = true;
+}
+/*------------------------------------------------------------------------*/
+
+void reset_executor() {
+  if (!initialized) return;
+  for (tool_run & run : slots) {
+    if (!run.pid) continue;
+    if (run.forkserver < 0) kill(-run.pid, SIGKILL);
+    kill(run.pid, SIGKILL);
+    if (run.forkserver < 0) waitpid(run.pid, 0, 0);
+  }
+  for (forkserver & server : forkservers) {
+    close(server.ctl_fd);
+    close(server.st_fd);
+    close(server.input_fd);
+    close(server.err_fd);
+    kill(server.pid, SIGKILL);
+    waitpid(server.pid, 0, 0);
+    unlink(server.input_path.c_str());
+    delete_coverage_map(server.map);
+  }
+  for (coverage_map & map : slot_maps) delete_coverage_map(map);
+  for (int fd : slot_err_fds) close(fd);
+  slot_maps.clear();
+  slot_err_fds.clear();
+  forkservers.clear();
+  slots.clear();
+  running = 0;
+  sigprocmask(SIG_SETMASK, &original_mask, 0);
+  sigaction(SIGCHLD, &original_SIGCHLD_action, 0);
+  initialized = false;
+}
+/*------------------------------------------------------------------------*/
+
+bool executor_full() { return running >= max_jobs; }
+
+unsigned executor_running() { return running; }
+
+/*------------------------------------------------------------------------*/
+/**
+    Sets the time and memory limits of the current process, only called in
+    the child before exec.
+*/
+static void set_resource_limits() {
+  struct rlimit limit;
+  if (time_limit > 0) {
+    limit.rlim_cur = static_cast<rlim_t>(ceil(time_limit));
+    limit.rlim_max = limit.rlim_cur + 1;
+    setrlimit(RLIMIT_CPU, &limit);
+  }
+  if (memory_limit) {
+    limit.rlim_cur = limit.rlim_max = static_cast<rlim_t>(memory_limit) << 20;
+    setrlimit(RLIMIT_AS, &limit);
+  }
+}
+/*------------------------------------------------------------------------*/
+/**
+    Sets up the forked child and executes the tool with input 'input' on
+    stdin and 'err' on stderr. Does not return.
+*/
+static void exec_tool(const tool & t, const char * path, int input, int err) {
+  std::vector<std::string> args = t.argv;
+  for (std::string & arg : args) {
+    size_t pos;
+    while ((pos = arg.find("@@")) != std::string::npos)
+      arg.replace(pos, 2, path);
+  }
+
+  sigprocmask(SIG_SETMASK, &original_mask, 0);
+  set_resource_limits();
+
+  int null = open("/dev/null", O_RDWR);
+  if (input < 0 || null < 0) _exit(127);
+  dup2(input, 0);
+  dup2(null, 1);
+  dup2(err, 2);
+  close(input);
+  close(null);
+
+  std::vector<char*> cargs;
+  for (std::string & arg : args) cargs.push_back(&arg[0]);
+  cargs.push_back(0);
+  execvp(cargs[0], cargs.data());
+  _exit(127);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Returns the index of an unused slot
+*/
+static unsigned free_slot() {
+  for (unsigned i = 0; i < slots.size(); i++)
+    if (!slots[i].pid) return i;
+  assert(0);
+  return 0;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Stores a started tool in the given slot
+*/
+static void add_tool_run(unsigned slot, pid_t pid, unsigned tool_idx,
+  unsigned job, int server, unsigned char * trace_bits) {
+  tool_run & run = slots[slot];
+  assert(!run.pid);
+  run = tool_run();
+  run.pid = pid;
+  run.job = job;
+  run.tool_idx = tool_idx;
+  run.forkserver = server;
+  run.trace_bits = trace_bits;
+  run.start = wall_clock_time();
+  running++;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Reads exactly four bytes from 'fd', waiting at most 'timeout' seconds.
+
+    @return true on success
+*/
+static bool read_word(int fd, int & word, double timeout) {
+  struct pollfd pfd;
+  pfd.fd = fd;
+  pfd.events = POLLIN;
+  if (poll(&pfd, 1, static_cast<int>(timeout * 1000)) <= 0) return false;
+  return read(fd, &word, 4) == 4;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Starts a fork server for the given tool and waits for its hello message.
+
+    @return index of the new fork server
+*/
+static unsigned start_forkserver(const tool & t, unsigned tool_idx) {
+  forkserver server;
+  server.tool_idx = tool_idx;
+  server.busy = false;
+  server.map.bits = 0;
+  if (collect_coverage) server.map = create_coverage_map();
+
+  char path[4096];
+  snprintf(path, sizeof path, "%s/agf-fs-%d-%zu.aig",
+    temporary_directory(), getpid(), forkservers.size());
+  server.input_path = path;
+  server.input_fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (server.input_fd < 0) die("can not create input file '%s'", path);
+  server.err_fd = create_stderr_file();
+
+  int ctl[2], st[2];
+  if (pipe(ctl) || pipe(st)) die("failed to create pipes for fork server");
+
+  server.pid = fork();
+  if (server.pid < 0) die("failed to fork '%s'", t.command.c_str());
+
+  if (!server.pid) {
+    setpgid(0, 0);
+    if (dup2(ctl[0], FORKSRV_FD) < 0 || dup2(st[1], FORKSRV_FD + 1) < 0)
+      _exit(127);
+    close(ctl[0]); close(ctl[1]);
+    close(st[0]); close(st[1]);
+    if (collect_coverage) export_coverage_map(server.map);
+    int input = t.uses_file ? open("/dev/null", O_RDONLY) : server.input_fd;
+    exec_tool(t, path, input, server.err_fd);
+  }
+
+  close(ctl[0]);
+  close(st[1]);
+  server.ctl_fd = ctl[1];
+  server.st_fd = st[0];
+  fcntl(server.ctl_fd, F_SETFD, FD_CLOEXEC);
+  fcntl(server.st_fd, F_SETFD, FD_CLOEXEC);
+  fcntl(server.input_fd, F_SETFD, FD_CLOEXEC);
+
+  int hello;
+  if (!read_word(server.st_fd, hello, 10))
+    die("tool '%s' does not answer as fork server", t.command.c_str());
+
+  forkservers.push_back(server);
+  return forkservers.size() - 1;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Hands the input to an idle fork server of the tool, which is started
+    first if necessary, and requests a fresh copy of the tool.
+*/
+static void execute_forkserver(const tool & t, unsigned tool_idx,
+  const std::string & data, unsigned job) {
+  unsigned idx = forkservers.size();
+  for (unsigned i = 0; i < forkservers.size(); i++) {
+    if (forkservers[i].tool_idx != tool_idx || forkservers[i].busy) continue;
+    idx = i;
+    break;
+  }
+  if (idx == forkservers.size()) idx = start_forkserver(t, tool_idx);
+
+  forkserver & server = forkservers[idx];
+  if (lseek(server.input_fd, 0, SEEK_SET) ||
+      write(server.input_fd, data.data(), data.size()) !=
+        static_cast<ssize_t>(data.size()) ||
+      ftruncate(server.input_fd, data.size()) ||
+      lseek(server.input_fd, 0, SEEK_SET))
+    die("failed to write input of fork server '%s'", server.input_path.c_str());
+
+  if (collect_coverage) memset(server.map.bits, 0, COVERAGE_MAP_SIZE);
+  if (ftruncate(server.err_fd, 0)) die("failed to truncate stderr file");
+
+  int request = 0, pid;
+  if (write(server.ctl_fd, &request, 4) != 4 ||
+      !read_word(server.st_fd, pid, 10) || pid <= 0)
+    die("fork server of tool '%s' failed", t.command.c_str());
+
+  server.busy = true;
+  add_tool_run(free_slot(), pid, tool_idx, job, idx, server.map.bits);
+}
+/*------------------------------------------------------------------------*/
+
+void execute_tool(const tool & t, unsigned tool_idx,
+  const char * path, const std::string & data, unsigned job) {
+  assert(initialized);
+  assert(!executor_full());
+
+  if (use_forkserver) {
+    execute_forkserver(t, tool_idx, data, job);
+    return;
+  }
+
+  unsigned slot = free_slot();
+  unsigned char * trace_bits = 0;
+  if (collect_coverage) {
+    trace_bits = slot_maps[slot].bits;
+    memset(trace_bits, 0, COVERAGE_MAP_SIZE);
+  }
+  if (ftruncate(slot_err_fds[slot], 0)) die("failed to truncate stderr file");
+
+  pid_t pid = fork();
+  if (pid < 0) die("failed to fork '%s'", t.command.c_str());
+
+  if (!pid) {
+    setpgid(0, 0);
+    if (collect_coverage) export_coverage_map(slot_maps[slot]);
+    exec_tool(t, path, open(t.uses_file ? "/dev/null" : path, O_RDONLY),
+      slot_err_fds[slot]);
+  }
+
+  add_tool_run(slot, pid, tool_idx, job, -1, trace_bits);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Kills all tools that exceed the time limit and returns the number of
+    seconds until the next tool reaches the time limit.
+*/
+static double kill_timeouts() {
+  double next = 1;
+  if (time_limit <= 0) return next;
+
+  double now = wall_clock_time();
+  for (tool_run & run : slots) {
+    if (!run.pid || run.timeout) continue;
+    double left = run.start + time_limit - now;
+    if (left <= 0) {
+      if (run.forkserver < 0) kill(-run.pid, SIGKILL);
+      kill(run.pid, SIGKILL);
+      run.timeout = true;
+    } else if (left < next) {
+      next = left;
+    }
+  }
+  return next;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Moves the terminated tool in 'run' to 'res' and frees its slot.
+*/
+static void finish_tool_run(tool_run & run, tool_run & res, int status) {
+  res = run;
+  res.wall_time = wall_clock_time() - run.start;
+  res.status = status;
+  if (WIFSIGNALED(status) && WTERMSIG(status) == SIGXCPU)
+    res.timeout = true;
+  run.pid = 0;
+  running--;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Collects a tool that was directly executed.
+
+    @return true if a tool terminated
+*/
+static bool collect_direct_run(tool_run & res) {
+  int status;
+  struct rusage u;
+  pid_t pid;
+
+  while ((pid = wait4(-1, &status, WNOHANG, &u)) > 0) {
+    for (tool_run & run : slots) {
+      if (run.pid != pid || run.forkserver >= 0) continue;
+      kill(-pid, SIGKILL);   // remove left over grand children
+      finish_tool_run(run, res, status);
+      read_stderr_file(slot_err_fds[&run - slots.data()], res.error_output);
+      res.cpu_time = u.ru_utime.tv_sec + 1e-6 * u.ru_utime.tv_usec;
+      res.cpu_time += u.ru_stime.tv_sec + 1e-6 * u.ru_stime.tv_usec;
+      res.max_rss = ((size_t) u.ru_maxrss) << 10;
+      return true;
+    }
+    for (forkserver & server : forkservers)
+      if (server.pid == pid)
+        die("fork server of tool %u terminated", server.tool_idx);
+  }
+  if (pid < 0 && errno != ECHILD && errno != EINTR)
+    die("waiting for tools failed");
+  return false;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Collects a tool that was forked by a fork server.
+
+    @return true if a tool terminated
+*/
+static bool collect_forkserver_run(tool_run & res, int timeout_ms) {
+  std::vector<struct pollfd> pfds;
+  std::vector<unsigned> servers;
+  for (unsigned i = 0; i < forkservers.size(); i++) {
+    if (!forkservers[i].busy) continue;
+    struct pollfd pfd;
+    pfd.fd = forkservers[i].st_fd;
+    pfd.events = POLLIN;
+    pfds.push_back(pfd);
+    servers.push_back(i);
+  }
+
+  struct timespec timeout;
+  timeout.tv_sec = timeout_ms / 1000;
+  timeout.tv_nsec = (timeout_ms % 1000) * 1000000L;
+  if (ppoll(pfds.data(), pfds.size(), &timeout, &original_mask) <= 0)
+    return false;
+
+  for (unsigned i = 0; i < pfds.size(); i++) {
+    if (!pfds[i].revents) continue;
+    forkserver & server = forkservers[servers[i]];
+    int status;
+    if (read(server.st_fd, &status, 4) != 4)
+      die("fork server of tool %u terminated", server.tool_idx);
+    server.busy = false;
+    for (tool_run & run : slots) {
+      if (!run.pid || run.forkserver != static_cast<int>(servers[i])) continue;
+      finish_tool_run(run, res, status);
+      read_stderr_file(server.err_fd, res.error_output);
+      return true;
+    }
+    assert(0);
+  }
+  return false;
+}
+/*------------------------------------------------------------------------*/
+
+bool collect_tool_run(tool_run & res, bool block) {
+  assert(initialized);
+
+  while (running) {
+    if (collect_direct_run(res)) return true;
+    double next = kill_timeouts();
+    int timeout_ms = block ? static_cast<int>(next * 1000) + 1 : 0;
+    if (collect_forkserver_run(res, timeout_ms)) return true;
+    if (!block || interrupt_signal) return false;
+  }
+  return false;
+}
+/*------------------------------------------------------------------------*/
+
+std::string describe_tool_run(const tool_run & run) {
+  char buffer[64];
+  if (run.timeout) {
+    snprintf(buffer, sizeof buffer, "timeout");
+  } else if (WIFSIGNALED(run.status)) {
+    snprintf(buffer, sizeof buffer, "signal %s",
+      signal_name(WTERMSIG(run.status)));
+  } else {
+    snprintf(buffer, sizeof buffer, "exit %d", WEXITSTATUS(run.status));
+  }
+  return buffer;
+}
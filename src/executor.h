@@ -0,0 +1,140 @@
+/*------------------------------------------------------------------------*/
+/*! \file executor.h
+    \brief contains a bounded process pool to execute the tools under test
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_EXECUTOR_H_
+#define AIGENFUZZER_SRC_EXECUTOR_H_
+/*------------------------------------------------------------------------*/
+#include <sys/types.h>
+
+#include <string>
+#include <vector>
+
+#include "coverage.h"
+/*------------------------------------------------------------------------*/
+
+/**
+    A tool under test, given as command line. The placeholder '@@' is
+    replaced by the name of the AIG file, otherwise the AIG is passed
+    on stdin.
+*/
+struct tool {
+  std::string command;             // /< command line as given by the user
+  std::vector<std::string> argv;   // /< command line split at white space
+  bool uses_file;                  // /< command contains '@@'
+};
+
+/**
+    Result of a single execution of a tool
+*/
+struct tool_run {
+  pid_t pid;            // /< process id, 0 if the slot is unused
+  unsigned job;         // /< job id, chosen by the caller
+  unsigned tool_idx;    // /< index of the executed tool
+  double start;         // /< wall clock time at start
+  double wall_time;     // /< elapsed wall clock time
+  double cpu_time;      // /< user and system time of the child
+  size_t max_rss;       // /< maximum resident set size of the child
+  int status;           // /< wait status as returned by wait4
+  bool timeout;         // /< killed because the time limit was reached
+  int forkserver;       // /< index of the fork server, -1 if executed directly
+  unsigned char * trace_bits;  // /< edge bitmap if coverage is collected,
+                               // /< valid until the next tool is executed
+  std::string error_output;    // /< end of the output on stderr
+};
+
+#define STDERR_LIMIT (1 << 16)   // /< kept bytes of the stderr of a tool
+
+extern unsigned max_jobs;        // /< number of parallel tool runs
+extern double time_limit;        // /< time limit per run in seconds, 0 = none
+extern size_t memory_limit;      // /< memory limit per run in MB, 0 = none
+extern const char * tmp_dir;     // /< directory for temporary AIG files
+extern bool use_forkserver;      // /< execute tools through a fork server
+
+/**
+    Splits the given command line at white space into a tool
+
+    @param command const char*
+
+    @return tool
+*/
+tool parse_tool(const char * command);
+
+/**
+    Returns the number of online CPUs, at least 1
+*/
+unsigned number_of_cores();
+
+/**
+    Returns the directory for temporary AIG files, which is 'tmp_dir' if
+    given, '/dev/shm' if available, and '/tmp' otherwise.
+*/
+const char * temporary_directory();
+
+/**
+    Initializes the process pool. Has to be called before the first tool is
+    executed, as it blocks SIGCHLD to wait for terminated children.
+*/
+void init_executor();
+
+/**
+    Kills all running tools and restores the signal mask
+*/
+void reset_executor();
+
+/**
+    Returns true if 'max_jobs' many tools are running
+*/
+bool executor_full();
+
+/**
+    Returns the number of running tools
+*/
+unsigned executor_running();
+
+/**
+    Starts the given tool on the AIG file 'path' in the background. The
+    resource limits are set in the child.
+
+    If 'use_forkserver' is set, the tool is started only once per parallel
+    job and stops at its fork server hook (see 'includes/agf_forkserver.h').
+    Then 'data' is copied to the input file of the fork server and a fresh
+    copy of the tool is forked. The CPU time and memory of tools started
+    by a fork server are not available.
+
+    @param t tool
+    @param tool_idx index of the tool, copied to the tool_run
+    @param path name of the AIG file
+    @param data content of the AIG file
+    @param job integer chosen by the caller, copied to the tool_run
+*/
+void execute_tool(const tool & t, unsigned tool_idx,
+  const char * path, const std::string & data, unsigned job);
+
+/**
+    Collects a terminated tool. Tools exceeding the time limit are killed.
+    The last STDERR_LIMIT bytes written to stderr are kept.
+
+    @param res tool_run, filled with the result
+    @param block if true wait until a tool terminates
+
+    @return true if a tool terminated, false if no tool is running,
+            'block' is false and no tool terminated yet, or the wait is
+            interrupted by SIGINT or SIGTERM (see 'interrupt_signal')
+*/
+bool collect_tool_run(tool_run & res, bool block);
+
+/**
+    Returns a short description of the termination of a tool run
+
+    @param run tool_run
+
+    @return std::string, e.g. "exit 10", "signal SIGSEGV" or "timeout"
+*/
+std::string describe_tool_run(const tool_run & run);
+
+#endif  // AIGENFUZZER_SRC_EXECUTOR_H_
@@ -7,6 +7,33 @@
 */
 /*------------------------------------------------------------------------*/
 #include "fuzzer.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "adder.h"
+#include "dedup.h"
+#include "level.h"
+#include "strash.h"
+#include "target.h"
+/*------------------------------------------------------------------------*/
+// Global Variables
+int technique = 0;
+int fuzz_operator = 0;
+int modifications = 1;
+bool strash_mutant = false;
+bool prune_mutant = false;
+aiger * donor_model = 0;
+const char * donor_name = 0;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+#define MAX_CROSSOVER_ANDS 64   // /< maximum size of a spliced cone
+#define MAX_DEPTH_ATTEMPTS 16   // /< literals drawn for a depth bounded input
+
 /*------------------------------------------------------------------------*/
 int rangeRandomZeroMax (int max){
     int n = max;
@@ -21,7 +48,9 @@ int rangeRandomZeroMax (int max){
 
 
 static unsigned choose_random_aiger_and(){
-   return 2*(rangeRandomZeroMax(A) + I + 1);
+   if(target_metric) return model->ands[choose_target_and()].lhs;
+   // independent of the encoding, latch variables may precede the ANDs
+   return model->ands[rangeRandomZeroMax(A)].lhs;
 }
 
 static unsigned choose_random_aiger_and_max(unsigned max){
@@ -36,6 +65,10 @@ static int choose_random_output(){
    return rangeRandomZeroMax(O);
 }
 
+static int choose_random_latch(){
+   return rangeRandomZeroMax(L);
+}
+
 /*------------------------------------------------------------------------*/
 
 static void flip_internal_sign_edge(){
@@ -51,11 +84,13 @@ static void flip_internal_sign_edge(){
   aiger_and * and_node = aiger_is_and (model, rand_lit);
   msg("  old: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
 
+  remove_and_from_hash(and_node);
   if(rhs){
     and_node->rhs1 =  and_node->rhs1 + 1 - 2*aiger_sign(and_node->rhs1);
   } else {
     and_node->rhs0 =  and_node->rhs0 + 1 - 2*aiger_sign(and_node->rhs0);
   }
+  add_and_to_hash(and_node);
   msg("  new: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
   msg("");
   msg("");
@@ -70,7 +105,9 @@ static void flip_internal_sign_node(){
   for (unsigned i = 0; i < O; i++){
     if (aiger_strip(model->outputs[i].lit) == rand_lit){
       msg("  selected output node %i %i", i, model->outputs[i].lit);
+      remove_output_from_hash(i);
       model->outputs[i].lit =  model->outputs[i].lit^1;
+      add_output_to_hash(i);
       msg("  new: %i", model->outputs[i].lit);
       msg("");
       msg("");
@@ -81,25 +118,39 @@ static void flip_internal_sign_node(){
   msg("  selected and node %i", rand_lit);
 
   aiger_and * and_node;
-  for(unsigned i = rand_lit/2; i < A; i++){
-    and_node = aiger_is_and (model, 2*i);
+  for(unsigned i = 0; i < A; i++){
+    and_node = model->ands + i;
 
     if(aiger_strip(and_node->rhs0) == rand_lit){
       msg("  old: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
+      remove_and_from_hash(and_node);
       and_node->rhs0 =  and_node->rhs0^1;
+      add_and_to_hash(and_node);
       msg("  new: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
       msg("");
 
 
     } else if (aiger_strip(and_node->rhs1) == rand_lit) {
       msg("  old: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
+      remove_and_from_hash(and_node);
       and_node->rhs1 =  and_node->rhs1^1;
+      add_and_to_hash(and_node);
       msg("  new: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
       msg("");
 
 
     }
   }
+
+  for(unsigned i = 0; i < L; i++){
+    if(aiger_strip(model->latches[i].next) != rand_lit) continue;
+    aiger_symbol * latch = model->latches + i;
+    msg("  latch %i old next: %i", latch->lit, latch->next);
+    remove_latch_from_hash(i);
+    latch->next = latch->next^1;
+    add_latch_to_hash(i);
+    msg("  latch %i new next: %i", latch->lit, latch->next);
+  }
   msg("");
 }
 /*------------------------------------------------------------------------*/
@@ -120,13 +171,31 @@ void flip_output_sign(){
 
   msg("  selected output node %i %i", rand_idx, rand_lit);
 
+  remove_output_from_hash(rand_idx);
   model->outputs[rand_idx].lit =  rand_lit^1;
+  add_output_to_hash(rand_idx);
 
   msg("  new: %i", model->outputs[rand_idx].lit);
   msg("");
   msg("");
 }
 
+/*------------------------------------------------------------------------*/
+/**
+    Chooses a random literal below the AND gate 'lhs' as its new input,
+    such that the depth of the model does not exceed 'max_depth'. If none
+    of the drawn literals is shallow enough, an input or latch is chosen.
+*/
+static unsigned choose_bounded_input(unsigned lhs){
+  int bound = max_input_level(lhs);
+  for(unsigned i = 0; i < MAX_DEPTH_ATTEMPTS; i++){
+    unsigned lit = choose_random_aiger_and_max(lhs);
+    if(static_cast<int>(model_level(lit)) <= bound) return lit;
+  }
+  unsigned idx = rangeRandomZeroMax(I + L);
+  unsigned lit = idx < I ? model->inputs[idx].lit : model->latches[idx-I].lit;
+  return lit ^ choose_random_rhs();
+}
 /*------------------------------------------------------------------------*/
 
 void change_input_of_internal_node(){
@@ -135,7 +204,8 @@ void change_input_of_internal_node(){
 
   unsigned rand_lit =  choose_random_aiger_and();
   int rhs = choose_random_rhs();
-  unsigned rand_input_lit =  choose_random_aiger_and_max(rand_lit);
+  unsigned rand_input_lit = max_depth ? choose_bounded_input(rand_lit) :
+    choose_random_aiger_and_max(rand_lit);
 
   assert(rand_input_lit < rand_lit);
 
@@ -145,11 +215,14 @@ void change_input_of_internal_node(){
   aiger_and * and_node = aiger_is_and (model, rand_lit);
   msg("  old: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
 
+  remove_and_from_hash(and_node);
   if(rhs){
     and_node->rhs1 =  rand_input_lit;
   } else {
     and_node->rhs0 =  rand_input_lit;
   }
+  add_and_to_hash(and_node);
+  if(max_depth) update_levels(rand_lit);
   msg("  new: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
   msg("");
   msg("");
@@ -184,6 +257,9 @@ static void and_constant_zero(){
   and_node = aiger_is_and (model, new_node);
   msg("  inserted: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
   aiger_reencode(model);
+  update_model_miloa();
+  // reencoding renumbers the AND gates above the inserted one
+  hash_model();
 
   msg("");
   msg("");
@@ -218,6 +294,9 @@ static void and_constant_one(){
   and_node = aiger_is_and (model, new_node);
   msg("  inserted: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
   aiger_reencode(model);
+  update_model_miloa();
+  // reencoding renumbers the AND gates above the inserted one
+  hash_model();
 
   msg("");
   msg("");
@@ -252,6 +331,9 @@ static void or_constant_zero(){
   and_node = aiger_is_and (model, new_node);
   msg("  inserted: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
   aiger_reencode(model);
+  update_model_miloa();
+  // reencoding renumbers the AND gates above the inserted one
+  hash_model();
 
   msg("");
   msg("");
@@ -286,6 +368,9 @@ static void or_constant_one(){
   and_node = aiger_is_and (model, new_node);
   msg("  inserted: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
   aiger_reencode(model);
+  update_model_miloa();
+  // reencoding renumbers the AND gates above the inserted one
+  hash_model();
 
   msg("");
   msg("");
@@ -310,3 +395,766 @@ void insert_constant(){
       break;
   }
 }
+
+/*------------------------------------------------------------------------*/
+/**
+    Collects the AND gates of the fanin cone of 'lit' in 'donor' in
+    topological order. At most MAX_CROSSOVER_ANDS gates are collected in
+    breadth-first order, the remaining gates become leaves of the cone.
+*/
+static void collect_donor_cone(aiger * donor, unsigned lit,
+  std::vector<aiger_and> & cone){
+  std::unordered_set<unsigned> in_cone;
+  std::vector<unsigned> bfs(1, aiger_strip(lit));
+  in_cone.insert(aiger_strip(lit));
+  for(size_t i = 0; i < bfs.size() && bfs.size() < MAX_CROSSOVER_ANDS; i++){
+    aiger_and * and_node = aiger_is_and(donor, bfs[i]);
+    unsigned children[2] = { aiger_strip(and_node->rhs0),
+                             aiger_strip(and_node->rhs1) };
+    for(unsigned child : children){
+      if(bfs.size() == MAX_CROSSOVER_ANDS) break;
+      if(!aiger_is_and(donor, child) || in_cone.count(child)) continue;
+      in_cone.insert(child);
+      bfs.push_back(child);
+    }
+  }
+
+  // post-order traversal restricted to the collected gates
+  std::unordered_set<unsigned> visited;
+  std::vector<std::pair<unsigned, bool>> stack(1, {bfs[0], false});
+  while(!stack.empty()){
+    unsigned node = stack.back().first;
+    bool expanded = stack.back().second;
+    stack.pop_back();
+    aiger_and * and_node = aiger_is_and(donor, node);
+    if(expanded){
+      cone.push_back(*and_node);
+      continue;
+    }
+    if(!visited.insert(node).second) continue;
+    stack.push_back({node, true});
+    unsigned children[2] = { aiger_strip(and_node->rhs1),
+                             aiger_strip(and_node->rhs0) };
+    for(unsigned child : children)
+      if(in_cone.count(child) && !visited.count(child))
+        stack.push_back({child, false});
+  }
+}
+/*------------------------------------------------------------------------*/
+/**
+    Replaces an input of a random AND gate by the fanin cone of a random
+    AND gate of 'donor_model', or of the model itself if no donor is given.
+    The leaves of the cone are mapped to random literals below the selected
+    gate, thus the result stays acyclic.
+*/
+static void crossover_cone(){
+  msg("Technique: Crossover - splice cone of donor");
+  msg("==========================================================");
+
+  aiger * donor = donor_model ? donor_model : model;
+
+  unsigned rand_lit =  choose_random_aiger_and();
+  int rhs = choose_random_rhs();
+
+  msg("  selected and node %i", rand_lit);
+  msg("  replacing rhs%i", rhs);
+
+  if(!donor->num_ands){
+    msg("  donor contains no AND gates");
+    msg("");
+    msg("");
+    return;
+  }
+
+  unsigned root = donor->ands[rangeRandomZeroMax(donor->num_ands)].lhs;
+
+  // the cone is copied before the model is extended, which may move the
+  // AND gates of the donor if the donor is the model itself
+  std::vector<aiger_and> cone;
+  collect_donor_cone(donor, root, cone);
+  msg("  donor cone of %i with %zu AND gates", root, cone.size());
+
+  std::unordered_map<unsigned, unsigned> mapped;   // donor var -> model lit
+  auto map_lit = [&](unsigned lit){
+    unsigned var = aiger_lit2var(lit);
+    if(!var) return lit;
+    auto it = mapped.find(var);
+    if(it == mapped.end())
+      it = mapped.emplace(var, choose_random_aiger_and_max(rand_lit)).first;
+    return it->second ^ aiger_sign(lit);
+  };
+
+  for(const aiger_and & and_node : cone){
+    unsigned rhs0 = map_lit(and_node.rhs0);
+    unsigned rhs1 = map_lit(and_node.rhs1);
+    unsigned new_node = 2*(++M);
+    aiger_add_and(model, new_node, rhs0, rhs1);
+    mapped[aiger_lit2var(and_node.lhs)] = new_node;
+  }
+
+  aiger_and * and_node = aiger_is_and (model, rand_lit);
+  msg("  old: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
+  if(rhs){
+    and_node->rhs1 = mapped[aiger_lit2var(root)];
+  } else {
+    and_node->rhs0 = mapped[aiger_lit2var(root)];
+  }
+  msg("  new: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
+  aiger_reencode(model);
+  update_model_miloa();
+  hash_model();
+
+  msg("");
+  msg("");
+}
+
+/*------------------------------------------------------------------------*/
+// Equivalence-preserving rewrites, which only change the structure
+
+/**
+    Redirects all references to the AND gate 'lit' in AND gates, latches
+    and outputs of 'aiger* model' to 'new_lit', keeping their signs.
+*/
+static void replace_fanouts(unsigned lit, unsigned new_lit){
+  assert(!aiger_sign(lit));
+  auto redirect = [&](unsigned & ref){
+    if(aiger_strip(ref) == lit) ref = new_lit ^ aiger_sign(ref);
+  };
+  for(unsigned i = 0; i < model->num_ands; i++){
+    redirect(model->ands[i].rhs0);
+    redirect(model->ands[i].rhs1);
+  }
+  for(unsigned i = 0; i < model->num_latches; i++)
+    redirect(model->latches[i].next);
+  for(unsigned i = 0; i < model->num_outputs; i++)
+    redirect(model->outputs[i].lit);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Searches an AND gate, starting at a random gate, that has an input for
+    which 'suitable' holds.
+
+    @param rhs set to the index of the suitable input
+    @return lhs of the AND gate, 0 if there is none
+*/
+template<typename F>
+static unsigned find_and_with_input(F suitable, int & rhs){
+  unsigned start = rangeRandomZeroMax(A);
+  int first = choose_random_rhs();
+  for(unsigned i = 0; i < A; i++){
+    aiger_and * and_node = model->ands + (start + i) % A;
+    unsigned inputs[2] = { and_node->rhs0, and_node->rhs1 };
+    for(int j = 0; j < 2; j++){
+      rhs = first ^ j;
+      if(suitable(inputs[rhs])) return and_node->lhs;
+    }
+  }
+  return 0;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Finishes a rewrite that extended 'aiger* model'
+*/
+static void finish_rewrite(){
+  aiger_reencode(model);
+  update_model_miloa();
+  hash_model();
+  msg("");
+  msg("");
+}
+/*------------------------------------------------------------------------*/
+/**
+    Replaces an input l of a random AND gate by two inverters in series,
+    built from the idempotent AND gates AND(!l,!l) and AND(!n,!n).
+*/
+static void double_inversion(){
+  msg("Technique: Equivalent rewrite - double inversion");
+  msg("==========================================================");
+
+  unsigned rand_lit =  choose_random_aiger_and();
+  int rhs = choose_random_rhs();
+  msg("  selected and node %i", rand_lit);
+
+  aiger_and * and_node = aiger_is_and (model, rand_lit);
+  unsigned lit = rhs ? and_node->rhs1 : and_node->rhs0;
+  msg("  old: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
+
+  unsigned first = 2*(++M), second = 2*(++M);
+  aiger_add_and(model, first, aiger_not(lit), aiger_not(lit));
+  aiger_add_and(model, second, aiger_not(first), aiger_not(first));
+
+  and_node = aiger_is_and (model, rand_lit);
+  if(rhs) and_node->rhs1 = second;
+  else and_node->rhs0 = second;
+  msg("  new: %i %i %i", and_node->lhs, and_node->rhs0, and_node->rhs1);
+  finish_rewrite();
+}
+/*------------------------------------------------------------------------*/
+/**
+    Applies De Morgan to an inverted AND gate input of an AND gate,
+    i.e., AND(!AND(p,q), b) = OR(!p, !q) & b, and distributes the OR:
+    !AND(!AND(!p,b), !AND(!q,b)). The fanouts of the gate are redirected to
+    the new structure.
+*/
+static void de_morgan(){
+  msg("Technique: Equivalent rewrite - De Morgan");
+  msg("==========================================================");
+
+  int rhs;
+  unsigned rand_lit = find_and_with_input([](unsigned lit){
+    return aiger_sign(lit) && aiger_is_and(model, aiger_strip(lit)); }, rhs);
+  if(!rand_lit){
+    msg("  no AND gate with an inverted AND gate input");
+    msg("");
+    msg("");
+    return;
+  }
+  msg("  selected and node %i", rand_lit);
+
+  aiger_and * and_node = aiger_is_and (model, rand_lit);
+  unsigned inverted = rhs ? and_node->rhs1 : and_node->rhs0;
+  unsigned other = rhs ? and_node->rhs0 : and_node->rhs1;
+  aiger_and * inner = aiger_is_and (model, aiger_strip(inverted));
+  unsigned p = inner->rhs0, q = inner->rhs1;
+  msg("  old: %i %i %i with %i %i %i", and_node->lhs, and_node->rhs0,
+    and_node->rhs1, inner->lhs, inner->rhs0, inner->rhs1);
+
+  unsigned left = 2*(++M), right = 2*(++M), root = 2*(++M);
+  aiger_add_and(model, left, aiger_not(p), other);
+  aiger_add_and(model, right, aiger_not(q), other);
+  aiger_add_and(model, root, aiger_not(left), aiger_not(right));
+  replace_fanouts(rand_lit, aiger_not(root));
+  msg("  new: !%i with %i %i %i, %i %i %i", root, root, aiger_not(left),
+    aiger_not(right), left, aiger_not(p), other);
+  finish_rewrite();
+}
+/*------------------------------------------------------------------------*/
+/**
+    Reassociates an AND tree, i.e., AND(a, AND(b,c)) becomes
+    AND(AND(a,b), c). The fanouts of the gate are redirected to the new
+    structure.
+*/
+static void reassociate(){
+  msg("Technique: Equivalent rewrite - reassociation");
+  msg("==========================================================");
+
+  int rhs;
+  unsigned rand_lit = find_and_with_input([](unsigned lit){
+    return !aiger_sign(lit) && aiger_is_and(model, lit); }, rhs);
+  if(!rand_lit){
+    msg("  no AND gate with an AND gate input");
+    msg("");
+    msg("");
+    return;
+  }
+  msg("  selected and node %i", rand_lit);
+
+  aiger_and * and_node = aiger_is_and (model, rand_lit);
+  unsigned a = rhs ? and_node->rhs0 : and_node->rhs1;
+  aiger_and * inner = aiger_is_and (model, rhs ? and_node->rhs1 :
+    and_node->rhs0);
+  // which input of the inner gate moves up is chosen randomly
+  int swap = choose_random_rhs();
+  unsigned b = swap ? inner->rhs1 : inner->rhs0;
+  unsigned c = swap ? inner->rhs0 : inner->rhs1;
+  msg("  old: %i %i %i with %i %i %i", and_node->lhs, and_node->rhs0,
+    and_node->rhs1, inner->lhs, inner->rhs0, inner->rhs1);
+
+  unsigned lower = 2*(++M), upper = 2*(++M);
+  aiger_add_and(model, lower, a, b);
+  aiger_add_and(model, upper, lower, c);
+  replace_fanouts(rand_lit, upper);
+  msg("  new: %i %i %i with %i %i %i", upper, lower, c, lower, a, b);
+  finish_rewrite();
+}
+/*------------------------------------------------------------------------*/
+/**
+    Swaps two random inputs together with their names, which renumbers the
+    variables after reencoding
+*/
+static void permute_inputs(){
+  msg("Technique: Equivalent rewrite - permute inputs");
+  msg("==========================================================");
+
+  if(I < 2){
+    msg("  less than two inputs");
+    msg("");
+    msg("");
+    return;
+  }
+  unsigned i = rangeRandomZeroMax(I);
+  unsigned j = (i + 1 + rangeRandomZeroMax(I - 1)) % I;
+  msg("  swapping inputs %u and %u", i, j);
+  std::swap(model->inputs[i], model->inputs[j]);
+  finish_rewrite();
+}
+/*------------------------------------------------------------------------*/
+/**
+    Swaps two random outputs together with their names
+*/
+static void permute_outputs(){
+  msg("Technique: Equivalent rewrite - permute outputs");
+  msg("==========================================================");
+
+  if(O < 2){
+    msg("  less than two outputs");
+    msg("");
+    msg("");
+    return;
+  }
+  unsigned i = rangeRandomZeroMax(O);
+  unsigned j = (i + 1 + rangeRandomZeroMax(O - 1)) % O;
+  msg("  swapping outputs %u and %u", i, j);
+  remove_output_from_hash(i);
+  remove_output_from_hash(j);
+  std::swap(model->outputs[i], model->outputs[j]);
+  add_output_to_hash(i);
+  add_output_to_hash(j);
+  msg("");
+  msg("");
+}
+/*------------------------------------------------------------------------*/
+void equivalent_rewrite(){
+  switch(rangeRandomZeroMax(5)){
+    case 0:
+      double_inversion();
+      break;
+    case 1:
+      de_morgan();
+      break;
+    case 2:
+      reassociate();
+      break;
+    case 3:
+      permute_inputs();
+      break;
+    case 4:
+      permute_outputs();
+      break;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+// Operators on the latches of sequential models
+
+/**
+    Prints that the model has no latch to modify
+
+    @return true if the model contains no latches
+*/
+static bool no_latches(){
+  if(L) return false;
+  msg("  model contains no latches");
+  msg("");
+  msg("");
+  return true;
+}
+/*------------------------------------------------------------------------*/
+static void flip_latch_next(){
+  msg("Technique: Modify latch - flip next state");
+  msg("==========================================================");
+  if(no_latches()) return;
+
+  unsigned idx = choose_random_latch();
+  aiger_symbol * latch = model->latches + idx;
+  msg("  selected latch %i", latch->lit);
+  msg("  old next: %i", latch->next);
+
+  remove_latch_from_hash(idx);
+  latch->next = latch->next^1;
+  add_latch_to_hash(idx);
+
+  msg("  new next: %i", latch->next);
+  msg("");
+  msg("");
+}
+/*------------------------------------------------------------------------*/
+static void change_latch_next(){
+  msg("Technique: Modify latch - change next state");
+  msg("==========================================================");
+  if(no_latches()) return;
+
+  unsigned idx = choose_random_latch();
+  aiger_symbol * latch = model->latches + idx;
+  msg("  selected latch %i", latch->lit);
+  msg("  old next: %i", latch->next);
+
+  // next state functions may depend on any literal without a cycle
+  remove_latch_from_hash(idx);
+  latch->next = choose_random_aiger_and_max(2*(M+1));
+  add_latch_to_hash(idx);
+
+  msg("  new next: %i", latch->next);
+  msg("");
+  msg("");
+}
+/*------------------------------------------------------------------------*/
+static void change_latch_reset(){
+  msg("Technique: Modify latch - change reset");
+  msg("==========================================================");
+  if(no_latches()) return;
+
+  unsigned idx = choose_random_latch();
+  aiger_symbol * latch = model->latches + idx;
+  msg("  selected latch %i", latch->lit);
+  msg("  old reset: %i", latch->reset);
+
+  // the reset is 0, 1, or the latch itself for an uninitialized latch,
+  // one of the two other values is selected
+  unsigned resets[3] = { aiger_false, aiger_true, latch->lit };
+  unsigned other[2], n = 0;
+  for(unsigned reset : resets)
+    if(reset != latch->reset) other[n++] = reset;
+  assert(n == 2);
+
+  remove_latch_from_hash(idx);
+  latch->reset = other[choose_random_rhs()];
+  add_latch_to_hash(idx);
+
+  msg("  new reset: %i", latch->reset);
+  msg("");
+  msg("");
+}
+/*------------------------------------------------------------------------*/
+void modify_latch(){
+  switch(rangeRandomZeroMax(3)){
+    case 0:
+      flip_latch_next();
+      break;
+    case 1:
+      change_latch_next();
+      break;
+    case 2:
+      change_latch_reset();
+      break;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+// Operators on the half and full adders of arithmetic circuits
+
+/**
+    Collects the adders of 'aiger* model'
+
+    @param full only collects full adders
+    @return false if there is none
+*/
+static bool find_model_adders(std::vector<adder> & adders, bool full){
+  find_adders(model, adders);
+  if(full)
+    adders.erase(std::remove_if(adders.begin(), adders.end(),
+      [](const adder & add){ return !add.half_sum; }), adders.end());
+  msg("  found %zu %sadders", adders.size(), full ? "full " : "");
+  if(!adders.empty()) return true;
+  msg("");
+  msg("");
+  return false;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Redirects the references to the literals 'subst[i].first' in AND gates,
+    latches and outputs to 'subst[i].second', keeping their signs. The
+    references inside of the adder itself are kept.
+*/
+static void redirect_adder_outputs(const adder & add,
+  const std::vector<std::pair<unsigned, unsigned>> & subst){
+  std::unordered_map<unsigned, unsigned> target;   // var -> literal
+  for(const auto & pair : subst)
+    target[aiger_lit2var(pair.first)] = pair.second ^ aiger_sign(pair.first);
+  std::unordered_set<unsigned> internal(add.gates.begin(), add.gates.end());
+
+  auto redirect = [&](unsigned & ref){
+    auto it = target.find(aiger_lit2var(ref));
+    if(it != target.end()) ref = it->second ^ aiger_sign(ref);
+  };
+  for(unsigned i = 0; i < model->num_ands; i++){
+    if(internal.count(aiger_lit2var(model->ands[i].lhs))) continue;
+    redirect(model->ands[i].rhs0);
+    redirect(model->ands[i].rhs1);
+  }
+  for(unsigned i = 0; i < model->num_latches; i++)
+    redirect(model->latches[i].next);
+  for(unsigned i = 0; i < model->num_outputs; i++)
+    redirect(model->outputs[i].lit);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Prints the inputs and outputs of an adder
+*/
+static void print_adder(const adder & add){
+  if(add.half_sum)
+    msg("  selected full adder of %i %i %i", add.inputs[0], add.inputs[1],
+      add.inputs[2]);
+  else
+    msg("  selected half adder of %i %i", add.inputs[0], add.inputs[1]);
+  msg("  sum %i, carry %i", add.sum, add.carry);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Swaps the sum and the carry of a random adder in all their fanouts
+*/
+static void swap_sum_carry(){
+  msg("Technique: Modify adder - swap sum and carry");
+  msg("==========================================================");
+
+  std::vector<adder> adders;
+  if(!find_model_adders(adders, false)) return;
+  const adder & add = adders[rangeRandomZeroMax(adders.size())];
+  print_adder(add);
+
+  // the fanouts are outside of the adder, thus no cycle is introduced
+  redirect_adder_outputs(add, { { add.sum, add.carry },
+                                { add.carry, add.sum } });
+  finish_rewrite();
+}
+/*------------------------------------------------------------------------*/
+/**
+    Replaces a random full adder by the half adder of its first two inputs,
+    i.e., the carry input is dropped
+*/
+static void full_to_half_adder(){
+  msg("Technique: Modify adder - replace full by half adder");
+  msg("==========================================================");
+
+  std::vector<adder> adders;
+  if(!find_model_adders(adders, true)) return;
+  const adder & add = adders[rangeRandomZeroMax(adders.size())];
+  print_adder(add);
+  msg("  new sum %i, carry %i", add.half_sum, add.half_carry);
+
+  redirect_adder_outputs(add, { { add.sum, add.half_sum },
+                                { add.carry, add.half_carry } });
+  finish_rewrite();
+}
+/*------------------------------------------------------------------------*/
+/**
+    Negates the sum or the carry of a random adder in all its fanouts
+*/
+static void flip_adder_output(){
+  msg("Technique: Modify adder - flip output");
+  msg("==========================================================");
+
+  std::vector<adder> adders;
+  if(!find_model_adders(adders, false)) return;
+  const adder & add = adders[rangeRandomZeroMax(adders.size())];
+  print_adder(add);
+
+  unsigned lit = choose_random_rhs() ? add.carry : add.sum;
+  msg("  flipping %s %i", lit == add.carry ? "carry" : "sum", lit);
+  redirect_adder_outputs(add, { { lit, aiger_not(lit) } });
+  finish_rewrite();
+}
+/*------------------------------------------------------------------------*/
+void modify_adder(){
+  switch(rangeRandomZeroMax(3)){
+    case 0:
+      swap_sum_carry();
+      break;
+    case 1:
+      full_to_half_adder();
+      break;
+    case 2:
+      flip_adder_output();
+      break;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+void load_donor(){
+  assert(donor_name);
+  assert(!donor_model);
+  donor_model = read_aiger_from_file(donor_name);
+  msg("  Donor File:      '%s' (%u AND gates)", donor_name,
+    donor_model->num_ands);
+}
+
+void reset_donor(){
+  if(donor_model) aiger_reset(donor_model);
+  donor_model = 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+int operator_technique(int op){
+  static const int techniques[NUM_OPERATORS] =
+    { 1, 1, 2, 3, 4, 4, 4, 4, 5, 6, 6, 6, 6, 6, 7, 7, 7, 8, 8, 8 };
+  assert(op >= 1 && op <= NUM_OPERATORS);
+  return techniques[op-1];
+}
+
+const char * operator_name(int op){
+  static const char * names[NUM_OPERATORS] = {
+    "flip edge sign", "flip node sign", "flip output sign", "change input",
+    "and constant 0", "and constant 1", "or constant 0", "or constant 1",
+    "crossover", "double inversion", "De Morgan", "reassociation",
+    "permute inputs", "permute outputs", "flip latch next",
+    "change next", "change reset", "swap sum carry", "full to half",
+    "flip adder out" };
+  assert(op >= 1 && op <= NUM_OPERATORS);
+  return names[op-1];
+}
+/*------------------------------------------------------------------------*/
+
+static void apply_operator(int op){
+  switch(op){
+    case 1:
+      flip_internal_sign_edge();
+      break;
+    case 2:
+      flip_internal_sign_node();
+      break;
+    case 3:
+      flip_output_sign();
+      break;
+    case 4:
+      change_input_of_internal_node();
+      break;
+    case 5:
+      and_constant_zero();
+      break;
+    case 6:
+      and_constant_one();
+      break;
+    case 7:
+      or_constant_zero();
+      break;
+    case 8:
+      or_constant_one();
+      break;
+    case 9:
+      crossover_cone();
+      break;
+    case 10:
+      double_inversion();
+      break;
+    case 11:
+      de_morgan();
+      break;
+    case 12:
+      reassociate();
+      break;
+    case 13:
+      permute_inputs();
+      break;
+    case 14:
+      permute_outputs();
+      break;
+    case 15:
+      flip_latch_next();
+      break;
+    case 16:
+      change_latch_next();
+      break;
+    case 17:
+      change_latch_reset();
+      break;
+    case 18:
+      swap_sum_carry();
+      break;
+    case 19:
+      full_to_half_adder();
+      break;
+    case 20:
+      flip_adder_output();
+      break;
+  }
+}
+/*------------------------------------------------------------------------*/
+/**
+    Selects a random technique. Crossover is only selected if a donor is
+    given, the latch operators only for sequential models, and the
+    equivalent rewrites and adder operators only if selected explicitly,
+    such that the seeds of existing reproduce lines keep their mutants.
+*/
+static int choose_random_technique(){
+  int techniques[6] = { 1, 2, 3, 4 };
+  int num_techniques = 4;
+  if(donor_model) techniques[num_techniques++] = 5;
+  if(L) techniques[num_techniques++] = 7;
+  return techniques[rangeRandomZeroMax(num_techniques)];
+}
+/*------------------------------------------------------------------------*/
+
+/**
+    Applies a single modification with the selected operator, the selected
+    technique, or a random technique
+*/
+static void apply_modification(){
+  if(fuzz_operator){
+    apply_operator(fuzz_operator);
+    return;
+  }
+  int sel_tech = technique ? technique : choose_random_technique();
+
+  switch(sel_tech){
+    case 1:
+      flip_internal_sign();
+      break;
+    case 2:
+      flip_output_sign();
+      break;
+    case 3:
+      change_input_of_internal_node();
+      break;
+    case 4:
+      insert_constant();
+      break;
+    case 5:
+      crossover_cone();
+      break;
+    case 6:
+      equivalent_rewrite();
+      break;
+    case 7:
+      modify_latch();
+      break;
+    case 8:
+      modify_adder();
+      break;
+  }
+}
+/*------------------------------------------------------------------------*/
+/**
+    Applies a single modification and undoes it if it increases the depth
+    of the model beyond 'max_depth'. Modifications of models that already
+    exceed the bound are kept as long as the depth does not increase.
+*/
+static void apply_bounded_modification(){
+  unsigned depth = model_depth();
+  aiger * saved = copy_aiger(model);
+  uint64_t saved_hash = model_hash;
+
+  apply_modification();
+
+  unsigned new_depth = model_depth();
+  if(new_depth > max_depth && new_depth > depth){
+    msg("  rejected modification, depth %u exceeds %u", new_depth, max_depth);
+    msg("");
+    load_model(saved);
+    model_hash = saved_hash;
+  }
+  aiger_reset(saved);
+}
+/*------------------------------------------------------------------------*/
+
+void fuzz_model(){
+  for(int i = 0; i < modifications; i++){
+    if(max_depth) apply_bounded_modification();
+    else apply_modification();
+  }
+
+  if(strash_mutant) strash_model();
+  if(prune_mutant) prune_cone_of_influence();
+  if(strash_mutant || prune_mutant) hash_model();
+}
+
+/*------------------------------------------------------------------------*/
+
+void generate_mutant(aiger * base, uint64_t base_hash, unsigned seed){
+  load_model(base);
+  model_hash = base_hash;
+  if(target_metric) prepare_target_table(base, base_hash);
+  srand(seed);
+  fuzz_model();
+}
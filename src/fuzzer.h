@@ -9,7 +9,20 @@
 #ifndef AIGENFUZZER_SRC_FUZZER_H_
 #define AIGENFUZZER_SRC_FUZZER_H_
 /*------------------------------------------------------------------------*/
+#include <stdint.h>
 #include "parser.h"
+/*------------------------------------------------------------------------*/
+
+#define NUM_OPERATORS 20       // /< number of sub-variants of all techniques
+
+extern int technique;          // /< selected technique, 0 for random
+extern int fuzz_operator;      // /< selected operator, 0 for random
+extern int modifications;      // /< number of modifications per mutant
+extern bool strash_mutant;     // /< apply structural hashing after fuzzing
+extern bool prune_mutant;      // /< remove ANDs outside of the cone of influence
+extern aiger * donor_model;    // /< second AIG for crossover, 0 = model itself
+extern const char * donor_name;  // /< file of the donor given by '--donor'
+/*------------------------------------------------------------------------*/
 
 int rangeRandomZeroMax (int max);
 
@@ -36,6 +49,86 @@ void change_input_of_internal_node();
 */
 void insert_constant();
 
+/**
+    Applies a random equivalence-preserving rewrite: double inversion,
+    De Morgan, reassociation, or a permutation of the inputs or outputs
+*/
+void equivalent_rewrite();
+
+/**
+    Modifies a random latch: flips the sign of its next state function,
+    replaces its next state function by a random literal, or changes its
+    reset value
+*/
+void modify_latch();
+
+/**
+    Modifies a random half or full adder: swaps its sum and carry, replaces
+    a full adder by a half adder, or negates its sum or carry
+*/
+void modify_adder();
+
+/**
+    Loads the AIG in the file 'donor_name' as 'aiger* donor_model'
+*/
+void load_donor();
+
+/**
+    Deallocates 'aiger* donor_model'
+*/
+void reset_donor();
+
+/**
+    Returns the technique an operator belongs to. The operators are the
+    sub-variants of the techniques:
+      1 flip sign of an edge, 2 flip sign of a node (technique 1),
+      3 flip sign of an output (technique 2),
+      4 change input of a node (technique 3),
+      5 AND constant zero, 6 AND constant one, 7 OR constant zero,
+      8 OR constant one (technique 4),
+      9 crossover with the donor (technique 5),
+      10 double inversion, 11 De Morgan, 12 reassociation,
+      13 permute inputs, 14 permute outputs (technique 6, equivalent),
+      15 flip latch next, 16 change latch next, 17 change latch reset
+      (technique 7),
+      18 swap sum and carry, 19 replace full by half adder,
+      20 flip adder output (technique 8)
+
+    @param op integer between 1 and NUM_OPERATORS
+*/
+int operator_technique(int op);
+
+/**
+    Returns a short name of the operator
+
+    @param op integer between 1 and NUM_OPERATORS
+*/
+const char * operator_name(int op);
+
+/*------------------------------------------------------------------------*/
+
+/**
+    Applies 'modifications' many modifications to 'aiger* model' using the
+    selected operator, the selected technique, or a random technique for
+    each modification. Crossover is only chosen as random technique if
+    'aiger* donor_model' is given, the latch operators only if the model
+    has latches, equivalent rewrites and adder operators never.
+    Afterwards structural hashing and pruning are applied if selected.
+*/
+void fuzz_model();
+
+/**
+    Replaces 'aiger* model' by a fresh copy of 'base' and fuzzes it with
+    the given seed. The result is the same mutant as generated by a single
+    run of AIGoFuzzing on 'base' with '-s seed'. The structural hash of the
+    mutant is derived from the hash of 'base' and stored in 'model_hash'.
+
+    @param base aiger*, e.g. 'aiger* base_model'
+    @param base_hash structural hash of 'base', see 'hash_aiger'
+    @param seed unsigned integer
+*/
+void generate_mutant(aiger * base, uint64_t base_hash, unsigned seed);
+
 
 
 #endif  // AIGENFUZZER_SRC_FUZZER_H_
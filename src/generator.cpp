@@ -0,0 +1,291 @@
+/*------------------------------------------------------------------------*/
+/*! \file generator.cpp
+    \brief contains the generation of multipliers and adders as AIGs
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "generator.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <unordered_map>
+#include <vector>
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+static const char * generator_names[] = {
+  "array", "wallace", "booth", "ripple", "cla" };
+
+static const char * generator_descriptions[] = {
+  "array multiplier", "Wallace-tree multiplier", "radix-4 Booth multiplier",
+  "ripple-carry adder", "Kogge-Stone adder" };
+
+typedef std::vector<unsigned> bits;   // /< literals, least significant first
+
+// / Structural hash table of the generated AND gates, (rhs0,rhs1) -> lhs
+static std::unordered_map<uint64_t, unsigned> and_table;
+
+/*------------------------------------------------------------------------*/
+
+int parse_generator(const char * name) {
+  for (int i = GEN_ARRAY; i <= GEN_CLA; i++)
+    if (!strcmp(name, generator_names[i])) return i;
+  return -1;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Adds the AND gate of 'a' and 'b' to 'aiger* model', unless it
+    simplifies to a constant or one of its inputs, or the same gate exists
+
+    @return literal of AND(a,b)
+*/
+static unsigned gen_and(unsigned a, unsigned b) {
+  if (a == aiger_false || b == aiger_false || a == aiger_not(b))
+    return aiger_false;
+  if (a == aiger_true || a == b) return b;
+  if (b == aiger_true) return a;
+  if (a < b) { unsigned tmp = a; a = b; b = tmp; }
+  unsigned & lhs = and_table[static_cast<uint64_t>(a) << 32 | b];
+  if (lhs) return lhs;
+  lhs = aiger_var2lit(model->maxvar + 1);
+  aiger_add_and(model, lhs, a, b);
+  return lhs;
+}
+/*------------------------------------------------------------------------*/
+
+static unsigned gen_or(unsigned a, unsigned b) {
+  return aiger_not(gen_and(aiger_not(a), aiger_not(b)));
+}
+/*------------------------------------------------------------------------*/
+
+static unsigned gen_xor(unsigned a, unsigned b) {
+  return gen_and(aiger_not(gen_and(a, b)),
+    aiger_not(gen_and(aiger_not(a), aiger_not(b))));
+}
+/*------------------------------------------------------------------------*/
+/**
+    Full adder of 'a', 'b' and 'c' of 7 AND gates, the carry shares XOR(a,b),
+    AND(a,b) and AND(c,XOR(a,b)) with the sum. If 'c' is constant zero, it
+    folds to a half adder of 3 AND gates.
+*/
+static void full_adder(unsigned a, unsigned b, unsigned c,
+  unsigned & sum, unsigned & carry) {
+  unsigned half_sum = gen_xor(a, b);
+  sum = gen_xor(half_sum, c);
+  carry = gen_or(gen_and(a, b), gen_and(c, half_sum));
+}
+/*------------------------------------------------------------------------*/
+/**
+    Adds the inputs 'prefix'0 to 'prefix'(width-1)
+
+    @return literals of the inputs
+*/
+static bits gen_inputs(const char * prefix, unsigned width) {
+  bits res(width);
+  char name[32];
+  for (unsigned i = 0; i < width; i++) {
+    res[i] = aiger_var2lit(model->maxvar + 1);
+    snprintf(name, sizeof(name), "%s%u", prefix, i);
+    aiger_add_input(model, res[i], name);
+  }
+  return res;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Ripple-carry addition of 'a' and 'b', which have the same width
+
+    @return sum with one more bit than the operands
+*/
+static bits ripple_add(const bits & a, const bits & b) {
+  assert(a.size() == b.size());
+  bits res(a.size() + 1);
+  unsigned carry = aiger_false;
+  for (size_t i = 0; i < a.size(); i++)
+    full_adder(a[i], b[i], carry, res[i], carry);
+  res[a.size()] = carry;
+  return res;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Kogge-Stone addition of 'a' and 'b', where the generate and propagate
+    signals are combined in a parallel prefix tree of logarithmic depth
+
+    @return sum with one more bit than the operands
+*/
+static bits kogge_stone_add(const bits & a, const bits & b) {
+  assert(a.size() == b.size());
+  size_t width = a.size();
+  bits propagate(width), generate(width), group_p(width), res(width + 1);
+  for (size_t i = 0; i < width; i++) {
+    propagate[i] = group_p[i] = gen_xor(a[i], b[i]);
+    generate[i] = gen_and(a[i], b[i]);
+  }
+  for (size_t d = 1; d < width; d *= 2) {
+    // descending, such that the signals of 'i-d' are those of the last step
+    for (size_t i = width; i-- > d; ) {
+      generate[i] = gen_or(generate[i], gen_and(group_p[i], generate[i-d]));
+      group_p[i] = gen_and(group_p[i], group_p[i-d]);
+    }
+  }
+  res[0] = propagate[0];
+  for (size_t i = 1; i < width; i++)
+    res[i] = gen_xor(propagate[i], generate[i-1]);
+  res[width] = generate[width-1];
+  return res;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Array multiplier, each row of partial products is added to the
+    accumulated sum by a ripple-carry adder
+*/
+static bits array_multiply(const bits & a, const bits & b) {
+  size_t width = a.size();
+  bits res(2 * width), row(width);
+  // 'acc' holds the sum of the rows added so far without its emitted bits
+  bits acc(width + 1, aiger_false);
+  for (size_t j = 0; j < width; j++) acc[j] = gen_and(a[j], b[0]);
+  for (size_t i = 0; i + 1 < width; i++) {
+    res[i] = acc[0];
+    for (size_t j = 0; j < width; j++) row[j] = gen_and(a[j], b[i+1]);
+    acc = ripple_add(bits(acc.begin() + 1, acc.end()), row);
+  }
+  res[width-1] = acc[0];
+  for (size_t j = 0; j < width; j++) res[width+j] = acc[j+1];
+  return res;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Wallace-tree reduction of the weighted bits in 'columns' modulo
+    2^columns.size(). In each layer the bits of a column are compressed in
+    groups of three by full adders and a remaining pair by a half adder,
+    until no column holds more than two bits, which are then added by a
+    ripple-carry adder.
+
+    @return sum with columns.size() bits
+*/
+static bits wallace_reduce(std::vector<bits> & columns) {
+  size_t width = columns.size();
+  bool reduced = false;
+  while (!reduced) {
+    reduced = true;
+    std::vector<bits> next(width);
+    for (size_t k = 0; k < width; k++) {
+      const bits & col = columns[k];
+      if (col.size() > 2) reduced = false;
+      size_t j = 0;
+      for (; j + 2 <= col.size() && col.size() > 2; j += 3) {
+        // a remaining pair is compressed by a half adder
+        unsigned sum, carry;
+        full_adder(col[j], col[j+1], j + 2 < col.size() ? col[j+2] :
+          aiger_false, sum, carry);
+        next[k].push_back(sum);
+        if (k + 1 < width) next[k+1].push_back(carry);
+      }
+      for (; j < col.size(); j++) next[k].push_back(col[j]);
+    }
+    if (!reduced) columns.swap(next);
+  }
+
+  bits res(width);
+  unsigned carry = aiger_false;
+  for (size_t k = 0; k < width; k++) {
+    bits & col = columns[k];
+    col.resize(2, aiger_false);
+    full_adder(col[0], col[1], carry, res[k], carry);
+  }
+  return res;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Wallace-tree multiplier, the partial products are reduced column-wise
+*/
+static bits wallace_multiply(const bits & a, const bits & b) {
+  size_t width = a.size();
+  std::vector<bits> columns(2 * width);
+  for (size_t i = 0; i < width; i++)
+    for (size_t j = 0; j < width; j++)
+      columns[i+j].push_back(gen_and(a[j], b[i]));
+  return wallace_reduce(columns);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Radix-4 Booth multiplier, the unsigned 'b' is zero extended and recoded
+    into the digits -2 to 2, each selecting a shifted and possibly negated
+    copy of 'a' as partial product, which are reduced by a Wallace tree
+*/
+static bits booth_multiply(const bits & a, const bits & b) {
+  size_t width = a.size();
+  std::vector<bits> columns(2 * width);
+  auto bit_a = [&](size_t j) { return j < width ? a[j] : aiger_false; };
+  auto bit_b = [&](size_t j) { return j < width ? b[j] : aiger_false; };
+
+  for (size_t i = 0; 2 * i <= width; i++) {
+    // digit -2*b(2i+1) + b(2i) + b(2i-1)
+    unsigned hi = bit_b(2*i+1), mid = bit_b(2*i);
+    unsigned lo = i ? bit_b(2*i-1) : aiger_false;
+    unsigned one = gen_xor(mid, lo);
+    unsigned two = gen_or(gen_and(hi, gen_and(aiger_not(mid), aiger_not(lo))),
+      gen_and(aiger_not(hi), gen_and(mid, lo)));
+    unsigned neg = hi;
+
+    // the partial product has width+1 magnitude bits, above it is sign
+    // extended with 'neg', and 'neg' is added to complete the negation
+    for (size_t j = 0; 2 * i + j < 2 * width; j++) {
+      unsigned bit = neg;
+      if (j <= width) {
+        unsigned shifted = j ? gen_and(two, bit_a(j-1)) : aiger_false;
+        bit = gen_xor(gen_or(gen_and(one, bit_a(j)), shifted), neg);
+      }
+      columns[2*i+j].push_back(bit);
+    }
+    if (neg != aiger_false) columns[2*i].push_back(neg);
+  }
+  return wallace_reduce(columns);
+}
+/*------------------------------------------------------------------------*/
+
+void generate_aig(int circuit, unsigned width) {
+  assert(circuit >= GEN_ARRAY && circuit <= GEN_CLA);
+  assert(width && width <= MAX_GEN_WIDTH);
+  init_aig_parsing();
+
+  msg("  Generated:       %u-bit %s", width,
+    generator_descriptions[circuit]);
+
+  bits a = gen_inputs("a", width);
+  bits b = gen_inputs("b", width);
+  bits res;
+  switch (circuit) {
+    case GEN_ARRAY:
+      res = array_multiply(a, b);
+      break;
+    case GEN_WALLACE:
+      res = wallace_multiply(a, b);
+      break;
+    case GEN_BOOTH:
+      res = booth_multiply(a, b);
+      break;
+    case GEN_RIPPLE:
+      res = ripple_add(a, b);
+      break;
+    default:
+      res = kogge_stone_add(a, b);
+      break;
+  }
+
+  char name[32];
+  for (size_t i = 0; i < res.size(); i++) {
+    snprintf(name, sizeof(name), "s%zu", i);
+    aiger_add_output(model, res[i], name);
+  }
+
+  and_table.clear();
+
+  // the operators expect the same order as for parsed AIGs
+  aiger_reencode(model);
+  check_aiger_model();
+}
@@ -0,0 +1,43 @@
+/*------------------------------------------------------------------------*/
+/*! \file generator.h
+    \brief contains the generation of multipliers and adders as AIGs
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_GENERATOR_H_
+#define AIGENFUZZER_SRC_GENERATOR_H_
+/*------------------------------------------------------------------------*/
+#include "parser.h"
+/*------------------------------------------------------------------------*/
+
+#define GEN_ARRAY 0       // /< array multiplier
+#define GEN_WALLACE 1     // /< Wallace-tree multiplier
+#define GEN_BOOTH 2       // /< radix-4 Booth multiplier with Wallace tree
+#define GEN_RIPPLE 3      // /< ripple-carry adder
+#define GEN_CLA 4         // /< carry-lookahead (Kogge-Stone) adder
+
+#define MAX_GEN_WIDTH 4096   // /< maximum bit-width of a generated circuit
+
+/**
+    Returns the circuit with the given name, or -1 if there is none
+
+    @param name 'array', 'wallace', 'booth', 'ripple' or 'cla'
+*/
+int parse_generator(const char * name);
+
+/**
+    Builds the circuit 'circuit' with two unsigned operands a and b of
+    'width' bits directly into a fresh 'aiger* model', such that it can be
+    fuzzed like a parsed AIG. Multipliers have the outputs s0 to
+    s(2*width-1), adders the outputs s0 to s(width). The AND gates are
+    ordered topologically, structurally hashed, and XORs are built as
+    AND(!AND(x,y), !AND(!x,!y)), thus the adders are found by 'find_adders'.
+
+    @param circuit one of GEN_ARRAY, ..., GEN_CLA
+    @param width unsigned integer between 1 and MAX_GEN_WIDTH
+*/
+void generate_aig(int circuit, unsigned width);
+
+#endif  // AIGENFUZZER_SRC_GENERATOR_H_
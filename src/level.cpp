@@ -0,0 +1,101 @@
+/*------------------------------------------------------------------------*/
+/*! \file level.cpp
+    \brief contains the logic levels of the AND gates and the depth bound
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "level.h"
+
+#include <algorithm>
+
+#include "dedup.h"
+/*------------------------------------------------------------------------*/
+// Global Variables
+unsigned max_depth = 0;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+static std::vector<unsigned> levels;   // /< levels of 'aiger* model'
+static uint64_t levels_hash;           // /< 'model_hash' of the levels
+
+/*------------------------------------------------------------------------*/
+/**
+    Returns the level of an AND gate given the levels of its inputs
+*/
+static unsigned and_level(const aiger_and * and_node,
+  const std::vector<unsigned> & levels) {
+  return 1 + std::max(levels[aiger_lit2var(and_node->rhs0)],
+    levels[aiger_lit2var(and_node->rhs1)]);
+}
+/*------------------------------------------------------------------------*/
+
+void compute_levels(const aiger * aig, std::vector<unsigned> & levels) {
+  levels.assign(aig->maxvar + 1, 0);
+  for (unsigned i = 0; i < aig->num_ands; i++)
+    levels[aiger_lit2var(aig->ands[i].lhs)] = and_level(aig->ands + i, levels);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Computes the levels of all variables of 'aiger* model'
+*/
+static void compute_model_levels() {
+  compute_levels(model, levels);
+  levels_hash = model_hash;
+}
+/*------------------------------------------------------------------------*/
+
+unsigned model_level(unsigned lit) {
+  if (levels_hash != model_hash || levels.size() != M + 1)
+    compute_model_levels();
+  return levels[aiger_lit2var(lit)];
+}
+/*------------------------------------------------------------------------*/
+
+unsigned model_depth() {
+  unsigned res = 0;
+  for (unsigned i = 0; i < O; i++)
+    res = std::max(res, model_level(model->outputs[i].lit));
+  for (unsigned i = 0; i < L; i++)
+    res = std::max(res, model_level(model->latches[i].next));
+  return res;
+}
+/*------------------------------------------------------------------------*/
+
+int max_input_level(unsigned lhs) {
+  // 'height' is the length of the longest path to an output or next
+  // state function, -1 for gates outside the cone of influence
+  std::vector<int> height(M + 1, -1);
+  for (unsigned i = 0; i < O; i++)
+    height[aiger_lit2var(model->outputs[i].lit)] = 0;
+  for (unsigned i = 0; i < L; i++)
+    height[aiger_lit2var(model->latches[i].next)] = 0;
+  for (unsigned i = A; i-- > 0; ) {
+    const aiger_and * and_node = model->ands + i;
+    int h = height[aiger_lit2var(and_node->lhs)];
+    if (h < 0) continue;
+    int & h0 = height[aiger_lit2var(and_node->rhs0)];
+    int & h1 = height[aiger_lit2var(and_node->rhs1)];
+    h0 = std::max(h0, h + 1);
+    h1 = std::max(h1, h + 1);
+  }
+  int h = height[aiger_lit2var(lhs)];
+  if (h < 0) return static_cast<int>(M);
+  return static_cast<int>(max_depth) - h - 1;
+}
+/*------------------------------------------------------------------------*/
+
+void update_levels(unsigned lhs) {
+  if (levels.size() != M + 1) {
+    compute_model_levels();
+    return;
+  }
+  aiger_and * and_node = aiger_is_and(model, lhs);
+  assert(and_node);
+  for (unsigned i = and_node - model->ands; i < A; i++)
+    levels[aiger_lit2var(model->ands[i].lhs)] =
+      and_level(model->ands + i, levels);
+  levels_hash = model_hash;
+}
@@ -0,0 +1,59 @@
+/*------------------------------------------------------------------------*/
+/*! \file level.h
+    \brief contains the logic levels of the AND gates and the depth bound
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_LEVEL_H_
+#define AIGENFUZZER_SRC_LEVEL_H_
+/*------------------------------------------------------------------------*/
+#include <vector>
+#include "parser.h"
+/*------------------------------------------------------------------------*/
+
+extern unsigned max_depth;   // /< maximum depth of a mutant, 0 = unbounded
+
+/**
+    Computes the logic level of every variable of 'aig' in linear time.
+    Constants, inputs and latches have level 0, an AND gate is one level
+    above its deeper input. The AND gates have to be ordered topologically.
+
+    @param aig aiger*
+    @param levels vector indexed by variables, resized to 'maxvar+1'
+*/
+void compute_levels(const aiger * aig, std::vector<unsigned> & levels);
+
+/**
+    Returns the depth of 'aiger* model', i.e., the maximum level of its
+    outputs and next state functions. The levels of the model are
+    recomputed if its structural hash has changed since they were last
+    computed or updated.
+*/
+unsigned model_depth();
+
+/**
+    Returns the level of the literal 'lit' in 'aiger* model'
+*/
+unsigned model_level(unsigned lit);
+
+/**
+    Returns the maximum level an input of the AND gate 'lhs' of 'aiger*
+    model' may have, such that the depth of the model does not exceed
+    'max_depth'. Computes the length of the longest path from the gate to
+    an output or next state function in linear time.
+
+    @return -1 if no input keeps the depth within the bound
+*/
+int max_input_level(unsigned lhs);
+
+/**
+    Updates the levels of 'aiger* model' after the inputs of the AND gate
+    'lhs' have been changed in place. Only the gate and the gates following
+    it in topological order are visited, thus the levels have to be up to
+    date before the change, e.g., by calling 'model_level'.
+*/
+void update_levels(unsigned lhs);
+
+#endif  // AIGENFUZZER_SRC_LEVEL_H_
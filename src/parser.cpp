@@ -7,6 +7,10 @@
 */
 /*------------------------------------------------------------------------*/
 #include "parser.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/stat.h>
 /*------------------------------------------------------------------------*/
 // Global Variables
 unsigned M, I, L, O, A;
@@ -15,6 +19,7 @@ unsigned M, I, L, O, A;
 // Local Variables
 
 aiger * model;   // /< aiger* object, used for storing the given AIG graph
+aiger * base_model;   // /< unmodified copy of the AIG, used for batch modes
 
 /*------------------------------------------------------------------------*/
 static unsigned get_model_num_latches() {return model->num_latches;}
@@ -31,8 +36,10 @@ void init_aig_parsing() {
 }
 /*------------------------------------------------------------------------*/
 void reset_aig_parsing() {
-  assert(model);
-  aiger_reset(model);
+  if (model) aiger_reset(model);
+  model = 0;
+  if (base_model) aiger_reset(base_model);
+  base_model = 0;
 }
 /*------------------------------------------------------------------------*/
 
@@ -73,19 +80,23 @@ const char* get_model_outputs_name(unsigned i) {
   return model->outputs[i].name;
 }
 /*------------------------------------------------------------------------*/
-/**
-    Checks whether the input AIG fullfills requirements.
-*/
-void check_aiger_model() {
-
+void update_model_miloa() {
+  assert(model);
   M = get_model_maxvar();
   I = get_model_num_inputs();
   L = get_model_num_latches();
   O = get_model_num_outputs();
   A = get_model_num_ands();
+}
+/*------------------------------------------------------------------------*/
+/**
+    Checks whether the input AIG fullfills requirements.
+*/
+void check_aiger_model() {
+
+  update_model_miloa();
 
-  if (L) die("unexpected behaviour: AIGoFuzzing can not handle latches yet");
-  if (!I) die("unexpected behaviour: model contains no inputs");
+  if (!I && !L) die("unexpected behaviour: model contains no inputs or latches");
   if (!O) die("unexpected behaviour: model contains no outputs");
 
   msg("  MILOA:           %u %u %u %u %u", M, I, L, O, A);
@@ -93,6 +104,17 @@ void check_aiger_model() {
   msg("");
 }
 
+/*------------------------------------------------------------------------*/
+/**
+    Reads the file 'input_name' into 'aig', or stdin if it is '-'
+
+    @return error message of the AIGER library, or 0
+*/
+static const char * read_aiger(aiger * aig, const char * input_name) {
+  if (is_standard_stream(input_name))
+    return aiger_read_from_file(aig, stdin);
+  return aiger_open_and_read_from_file(aig, input_name);
+}
 /*------------------------------------------------------------------------*/
 
 void parse_aig(const char * input_name) {
@@ -100,24 +122,130 @@ void parse_aig(const char * input_name) {
   init_aig_parsing();
 
   msg("  Input File:      '%s'", input_name);
-  const char * err = aiger_open_and_read_from_file(model, input_name);
+  const char * err = read_aiger(model, input_name);
   if (err) die("error parsing '%s': %s", input_name, err);
 
+  // the operators expect the inputs, latches and AND gates in this order,
+  // with the AND gates sorted topologically
+  aiger_reencode(model);
   check_aiger_model();
   assert(model);
 }
 
+/*------------------------------------------------------------------------*/
+
+aiger * read_aiger_from_file(const char * input_name) {
+  assert(input_name);
+  aiger * res = aiger_init();
+  const char * err = read_aiger(res, input_name);
+  if (err) die("error parsing '%s': %s", input_name, err);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+/**
+    Copies 'src' into a fresh aiger object, including its properties. If
+    'keep' is given, only the latches and AND gates whose variable is
+    marked in 'keep' are copied.
+*/
+static aiger * copy_aiger_filtered(aiger * src, const unsigned char * keep) {
+  aiger * dst = aiger_init();
+
+  for (unsigned i = 0; i < src->num_inputs; i++) {
+    aiger_symbol * input = src->inputs + i;
+    aiger_add_input(dst, input->lit, input->name);
+  }
+
+  for (unsigned i = 0; i < src->num_latches; i++) {
+    aiger_symbol * latch = src->latches + i;
+    if (keep && !keep[aiger_lit2var(latch->lit)]) continue;
+    aiger_add_latch(dst, latch->lit, latch->next, latch->name);
+    aiger_add_reset(dst, latch->lit, latch->reset);
+  }
+
+  for (unsigned i = 0; i < src->num_ands; i++) {
+    aiger_and * and_node = src->ands + i;
+    if (keep && !keep[aiger_lit2var(and_node->lhs)]) continue;
+    aiger_add_and(dst, and_node->lhs, and_node->rhs0, and_node->rhs1);
+  }
+
+  for (unsigned i = 0; i < src->num_outputs; i++) {
+    aiger_symbol * output = src->outputs + i;
+    aiger_add_output(dst, output->lit, output->name);
+  }
+
+  // the properties are roots of 'aiger_coi', thus their cones are kept
+  for (unsigned i = 0; i < src->num_bad; i++)
+    aiger_add_bad(dst, src->bad[i].lit, src->bad[i].name);
+  for (unsigned i = 0; i < src->num_constraints; i++)
+    aiger_add_constraint(dst, src->constraints[i].lit,
+      src->constraints[i].name);
+  for (unsigned i = 0; i < src->num_justice; i++)
+    aiger_add_justice(dst, src->justice[i].size, src->justice[i].lits,
+      src->justice[i].name);
+  for (unsigned i = 0; i < src->num_fairness; i++)
+    aiger_add_fairness(dst, src->fairness[i].lit, src->fairness[i].name);
+
+  for (char ** p = src->comments; *p; p++) aiger_add_comment(dst, *p);
+
+  return dst;
+}
+/*------------------------------------------------------------------------*/
+
+aiger * copy_aiger(aiger * src) {
+  assert(src);
+  return copy_aiger_filtered(src, 0);
+}
+/*------------------------------------------------------------------------*/
+
+void store_base_model() {
+  assert(model);
+  assert(!base_model);
+  base_model = copy_aiger(model);
+}
+/*------------------------------------------------------------------------*/
+
+void load_model(aiger * src) {
+  assert(src);
+  if (model) aiger_reset(model);
+  model = copy_aiger(src);
+  update_model_miloa();
+}
+/*------------------------------------------------------------------------*/
+
+unsigned prune_cone_of_influence() {
+  assert(model);
+  aiger * pruned = copy_aiger_filtered(model, aiger_coi(model));
+
+  unsigned removed = model->num_ands - pruned->num_ands;
+
+  aiger_reset(model);
+  model = pruned;
+  aiger_reencode(model);
+  update_model_miloa();
+
+  msg("Cone of influence");
+  msg("==========================================================");
+  msg("  removed %u AND gates outside of the cone of influence", removed);
+  msg("  MILOA:           %u %u %u %u %u", M, I, L, O, A);
+  msg("");
+
+  return removed;
+}
+
 /*=========================================================================*/
 
 void write_fuzzed_model(const char * output_name) {
 
-  FILE * output_file;
-  if (!(output_file = fopen(output_name, "w")))
-      die("can not write output to '%s'", output_name);
+  FILE * output_file = open_output_file(output_name);
 
   if (!aiger_write_to_file(model, aiger_binary_mode, output_file))
         die("failed to write rewritten aig to '%s'", output_name);
 
+  if (!close_output_file(output_file))
+        die("failed to write rewritten aig to '%s'", output_name);
+
   msg("Output");
   msg("==========================================================");
   msg("  Printed fuzzed AIG to: '%s'", output_name);
@@ -125,3 +253,124 @@ void write_fuzzed_model(const char * output_name) {
 
 }
 /*------------------------------------------------------------------------*/
+
+static int put_to_string(char ch, std::string * buffer) {
+  buffer->push_back(ch);
+  return static_cast<unsigned char>(ch);
+}
+/*------------------------------------------------------------------------*/
+
+void write_model_to_buffer(std::string & buffer) {
+  write_aiger_to_buffer(model, buffer);
+}
+/*------------------------------------------------------------------------*/
+
+void write_aiger_to_buffer(aiger * aig, std::string & buffer) {
+  buffer.clear();
+  if (!aiger_write_generic(aig, aiger_binary_mode, &buffer,
+        (aiger_put) put_to_string))
+    die("failed to write rewritten aig to buffer");
+}
+/*------------------------------------------------------------------------*/
+
+void write_buffer_to_file(const char * path, const std::string & data) {
+  FILE * file;
+  if (!(file = fopen(path, "w")))
+    die("can not write output to '%s'", path);
+  if (fwrite(data.data(), 1, data.size(), file) != data.size())
+    die("failed to write output to '%s'", path);
+  fclose(file);
+}
+/*------------------------------------------------------------------------*/
+
+bool is_standard_stream(const char * name) {
+  return !strcmp(name, "-");
+}
+/*------------------------------------------------------------------------*/
+
+FILE * open_output_file(const char * name) {
+  if (is_standard_stream(name)) return stdout;
+  FILE * file;
+  if (!(file = fopen(name, "w")))
+    die("can not write output to '%s'", name);
+  return file;
+}
+/*------------------------------------------------------------------------*/
+
+bool close_output_file(FILE * file) {
+  if (file == stdout) return !fflush(stdout);
+  return !fclose(file);
+}
+/*------------------------------------------------------------------------*/
+
+void read_file_to_buffer(const char * path, std::string & data) {
+  FILE * file;
+  if (!(file = fopen(path, "r")))
+    die("can not read input file '%s'", path);
+  data.clear();
+  char buffer[4096];
+  size_t bytes;
+  while ((bytes = fread(buffer, 1, sizeof buffer, file)))
+    data.append(buffer, bytes);
+  fclose(file);
+}
+/*------------------------------------------------------------------------*/
+
+bool read_line(FILE * file, std::string & line) {
+  line.clear();
+  int c;
+  while ((c = getc(file)) != EOF && c != '\n') line += c;
+  return c != EOF;
+}
+/*------------------------------------------------------------------------*/
+
+void buffered_writer::flush() {
+  if (file && !buffer.empty() &&
+      fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size())
+    die("failed to write output to '%s'", name);
+  if (file) buffer.clear();
+}
+/*------------------------------------------------------------------------*/
+
+void buffered_writer::put_int(int64_t val) {
+  char digits[24];
+  unsigned len = 0;
+  uint64_t abs = val < 0 ? -static_cast<uint64_t>(val) : val;
+  do { digits[len++] = '0' + abs % 10; abs /= 10; } while (abs);
+  if (val < 0) buffer.push_back('-');
+  while (len) buffer.push_back(digits[--len]);
+}
+/*------------------------------------------------------------------------*/
+
+void make_directory(const char * dir) {
+  if (mkdir(dir, 0777) && errno != EEXIST)
+    die("can not create directory '%s'", dir);
+}
+/*------------------------------------------------------------------------*/
+
+/**
+    Reader state for 'aiger_read_generic' on a std::string
+*/
+struct buffer_reader {
+  const std::string * buffer;
+  size_t pos;
+};
+
+static int get_from_string(buffer_reader * reader) {
+  if (reader->pos == reader->buffer->size()) return EOF;
+  return static_cast<unsigned char>((*reader->buffer)[reader->pos++]);
+}
+/*------------------------------------------------------------------------*/
+
+aiger * read_aiger_from_buffer(const std::string & buffer) {
+  buffer_reader reader;
+  reader.buffer = &buffer;
+  reader.pos = 0;
+
+  aiger * res = aiger_init();
+  const char * err = aiger_read_generic(res, &reader,
+    (aiger_get) get_from_string);
+  if (err) die("error parsing buffered AIG: %s", err);
+  return res;
+}
+/*------------------------------------------------------------------------*/
@@ -10,6 +10,10 @@
 #define AIGENFUZZER_SRC_PARSER_H_
 /*------------------------------------------------------------------------*/
 #include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
 
 #include "signal_statistics.h"
 
@@ -25,6 +29,7 @@ extern unsigned O;   // /< stores the maximum variable num of the input AIG
 extern unsigned A;   // /< stores the maximum variable num of the input AIG
 
 extern aiger * model;
+extern aiger * base_model;
 /*------------------------------------------------------------------------*/
 
 /**
@@ -83,22 +88,174 @@ const char* get_model_inputs_name(unsigned i);
 unsigned get_model_outputs_lit(unsigned i);
 
 
+/**
+    Updates the global variables M, I, L, O, A to the current 'aiger* model'.
+    Has to be called whenever the model is reencoded or rebuilt.
+*/
+void update_model_miloa();
+
+/**
+    Checks whether 'aiger* model' has inputs or latches and outputs, and
+    updates M, I, L, O, A.
+*/
+void check_aiger_model();
+
 /**
     Reads the input aiger given in the file called input_name to the aiger 'model'
-    using the parserer function of aiger.h
+    using the parserer function of aiger.h, stdin if input_name is '-'
 
     @param input_name char * ame of input file
 */
 void parse_aig(const char * input_name);
 
+/**
+    Reads the AIG in the file called input_name into a fresh aiger object.
+
+    @param input_name char * name of input file
+
+    @return aiger* which has to be deallocated by 'aiger_reset'
+*/
+aiger * read_aiger_from_file(const char * input_name);
+
+
+/**
+    Returns a copy of the given aiger object.
+
+    @param src aiger*
+
+    @return aiger* which has to be deallocated by 'aiger_reset'
+*/
+aiger * copy_aiger(aiger * src);
+
+/**
+    Stores a copy of the unmodified 'aiger* model' as 'aiger* base_model'.
+*/
+void store_base_model();
+
+/**
+    Replaces 'aiger* model' by a fresh copy of the given AIG.
+
+    @param src aiger*, e.g. 'aiger* base_model'
+*/
+void load_model(aiger * src);
+
+/**
+    Removes all latches and AND gates of 'aiger* model' that are not in the
+    cone of influence of an output. Inputs are kept, even if they are
+    dangling.
+
+    @return number of removed AND gates
+*/
+unsigned prune_cone_of_influence();
 
 /**
-    Writes the 'aiger* model' to the provided file.
+    Writes the 'aiger* model' to the provided file, stdout if it is '-'.
 
     @param file output file
 
 */
 void write_fuzzed_model(const char * output_name);
 
+/**
+    Writes the 'aiger* model' in binary AIGER format to the given buffer.
+
+    @param buffer std::string, previous content is discarded
+*/
+void write_model_to_buffer(std::string & buffer);
+
+/**
+    Writes 'aig' in binary AIGER format to the given buffer. The writer
+    reencodes 'aig' if needed, thus it must not be shared between threads.
+
+    @param aig aiger*
+    @param buffer std::string, previous content is discarded
+*/
+void write_aiger_to_buffer(aiger * aig, std::string & buffer);
+
+/**
+    Reads an AIG in AIGER format from the given buffer.
+
+    @param buffer std::string
+
+    @return aiger* which has to be deallocated by 'aiger_reset'
+*/
+aiger * read_aiger_from_buffer(const std::string & buffer);
+
+/**
+    Writes the given buffer to the file 'path'.
+
+    @param path name of the output file
+    @param data std::string
+*/
+void write_buffer_to_file(const char * path, const std::string & data);
+
+/**
+    Returns true if 'name' is '-', i.e., stdin as input or stdout as output.
+*/
+bool is_standard_stream(const char * name);
+
+/**
+    Opens the file 'name' for writing, or returns stdout if 'name' is '-'.
+
+    @param name name of the output file
+    @return FILE* to be closed by 'close_output_file'
+*/
+FILE * open_output_file(const char * name);
+
+/**
+    Closes a file opened by 'open_output_file', stdout is only flushed.
+
+    @return false if writing failed
+*/
+bool close_output_file(FILE * file);
+
+/**
+    Reads the content of the file 'path' into the given buffer.
+
+    @param path name of the input file
+    @param data std::string, overwritten
+*/
+void read_file_to_buffer(const char * path, std::string & data);
+
+/**
+    Reads the rest of the current line of 'file' without the newline.
+
+    @param file FILE*
+    @param line std::string, overwritten
+    @return false if the end of the file is reached
+*/
+bool read_line(FILE * file, std::string & line);
+
+#define WRITER_BUFFER_SIZE (1 << 16)   // /< bytes written to a file at once
+
+/**
+    Appends text to a string and, if 'file' is set, flushes it to the file
+    whenever it exceeds WRITER_BUFFER_SIZE, such that large encodings are
+    written without keeping them in memory.
+*/
+struct buffered_writer {
+  std::string & buffer;   // /< pending output
+  FILE * file;            // /< destination, or 0 to keep the whole output
+  const char * name;      // /< name of 'file' for error messages
+
+  /** Writes the pending output to 'file', if it is set */
+  void flush();
+
+  /** Flushes the pending output if it exceeds WRITER_BUFFER_SIZE */
+  void flush_if_full() {
+    if (file && buffer.size() >= WRITER_BUFFER_SIZE) flush();
+  }
+
+  /** Appends the decimal representation of 'val' */
+  void put_int(int64_t val);
+};
+
+/**
+    Creates the directory 'dir' unless it already exists.
+
+    @param dir name of the directory
+*/
+void make_directory(const char * dir);
+
 
 #endif  // AIGENFUZZER_SRC_PARSER_H_
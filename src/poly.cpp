@@ -0,0 +1,325 @@
+/*------------------------------------------------------------------------*/
+/*! \file poly.cpp
+    \brief contains the encoding of the AIG as polynomials for algebraic
+    verification
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "poly.h"
+
+#include <gmp.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <vector>
+/*------------------------------------------------------------------------*/
+// Global Variables
+bool poly_output = false;
+int poly_spec = POLY_SPEC_AUTO;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+/**
+    A term 'coef*u*v' of a polynomial, variable 0 stands for the factor 1
+*/
+struct term {
+  int coef;      // /< integer coefficient
+  unsigned u;    // /< larger variable, 0 if the term is constant
+  unsigned v;    // /< smaller variable, 0 if the term is linear
+};
+
+/**
+    State of the encoding of one AIG, local such that several AIGs can be
+    encoded concurrently
+*/
+struct poly_encoder {
+  buffered_writer & out;              // /< destination of the polynomials
+  aiger * aig;                        // /< encoded AIG
+  std::vector<int> input_idx;         // /< index of the input variables
+  unsigned operand_width;             // /< n if named a0.. and b0..
+  std::vector<unsigned> operand_bit;  // /< input index -> bit of a, n + bit of b
+  std::vector<unsigned> operand_input;  // /< inverse of 'operand_bit'
+  std::vector<std::string> powers;    // /< decimal powers of two
+};
+
+/*------------------------------------------------------------------------*/
+/**
+    Appends the name of the AIG variable 'var'
+*/
+static void put_var(poly_encoder & enc, unsigned var) {
+  buffered_writer & out = enc.out;
+  unsigned operand_width = enc.operand_width;
+  int idx = enc.input_idx[var];
+  if (idx < 0) {
+    out.buffer.push_back('l');
+    out.put_int(var);
+  } else if (operand_width) {
+    unsigned bit = enc.operand_bit[idx];
+    out.buffer.push_back(bit < operand_width ? 'a' : 'b');
+    out.put_int(bit < operand_width ? bit : bit - operand_width);
+  } else {
+    out.buffer.push_back('i');
+    out.put_int(idx);
+  }
+}
+/*------------------------------------------------------------------------*/
+/**
+    Appends ' + ' or ' - ' before a term, or only '-' before the first one
+
+    @param first true if no term of the polynomial is written yet
+*/
+static void put_sign(buffered_writer & out, bool negative, bool first) {
+  if (first) {
+    if (negative) out.buffer.push_back('-');
+  } else {
+    out.buffer += negative ? " - " : " + ";
+  }
+}
+/*------------------------------------------------------------------------*/
+/**
+    Appends the polynomial '-lhs + terms', where terms of the same monomial
+    are already merged and terms with coefficient 0 are skipped
+
+    @param put_lhs writes the name of the left-hand side
+*/
+template<typename T>
+static void put_polynomial(poly_encoder & enc, T put_lhs,
+  const std::vector<term> & terms) {
+  buffered_writer & out = enc.out;
+  out.buffer.push_back('-');
+  put_lhs();
+  for (const term & t : terms) {
+    if (!t.coef) continue;
+    put_sign(out, t.coef < 0, false);
+    int abs = t.coef < 0 ? -t.coef : t.coef;
+    if (!t.u) {
+      out.put_int(abs);
+      continue;
+    }
+    if (abs != 1) {
+      out.put_int(abs);
+      out.buffer.push_back('*');
+    }
+    if (t.v) {
+      put_var(enc, t.v);
+      out.buffer.push_back('*');
+    }
+    put_var(enc, t.u);
+  }
+  out.buffer += ";\n";
+  out.flush_if_full();
+}
+/*------------------------------------------------------------------------*/
+/**
+    Adds 'coef*u*v' to 'terms', merging it with a term of the same monomial
+*/
+static void add_term(std::vector<term> & terms, int coef, unsigned u,
+  unsigned v) {
+  if (u == v) v = 0;                  // boolean variables, u*u = u
+  if (u < v) { unsigned tmp = u; u = v; v = tmp; }
+  for (term & t : terms)
+    if (t.u == u && t.v == v) { t.coef += coef; return; }
+  terms.push_back({ coef, u, v });
+}
+/*------------------------------------------------------------------------*/
+/**
+    Adds the terms of the literal 'lit' to 'terms', i.e., 'var' or '1-var'
+*/
+static void literal_terms(unsigned lit, std::vector<term> & terms) {
+  unsigned var = aiger_lit2var(lit);
+  if (aiger_sign(lit)) add_term(terms, 1, 0, 0);
+  if (var) add_term(terms, aiger_sign(lit) ? -1 : 1, var, 0);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Adds the expanded terms of 'AND(lit0, lit1)' to 'terms', ordered by
+    decreasing degree
+*/
+static void and_terms(unsigned lit0, unsigned lit1,
+  std::vector<term> & terms) {
+  std::vector<term> p0, p1;
+  literal_terms(lit0, p0);
+  literal_terms(lit1, p1);
+  for (const term & t0 : p0)
+    for (const term & t1 : p1) {
+      if (t0.u && t1.u) add_term(terms, t0.coef * t1.coef, t0.u, t1.u);
+      else add_term(terms, t0.coef * t1.coef, t0.u | t1.u, 0);
+    }
+  std::stable_sort(terms.begin(), terms.end(),
+    [](const term & x, const term & y) {
+      return !!x.u + !!x.v > !!y.u + !!y.v;
+    });
+}
+/*------------------------------------------------------------------------*/
+/**
+    Appends the specification '-S + A*B' or '-S + A + B', where the outputs
+    are named 's<i>'
+*/
+static void put_specification(poly_encoder & enc, int spec) {
+  buffered_writer & out = enc.out;
+  const aiger * aig = enc.aig;
+  const std::vector<std::string> & powers = enc.powers;
+  unsigned n = enc.operand_width;
+  unsigned num_outputs = aig->num_outputs;
+  for (unsigned i = 0; i < num_outputs; i++) {
+    put_sign(out, true, !i);
+    if (i) out.buffer += powers[i] + "*";
+    out.buffer += "s";
+    out.put_int(i);
+    out.flush_if_full();
+  }
+  if (spec == POLY_SPEC_MULT) {
+    for (unsigned i = 0; i < n; i++)
+      for (unsigned j = 0; j < n; j++) {
+        out.buffer += " + ";
+        if (i + j) out.buffer += powers[i + j] + "*";
+        put_var(enc, aiger_lit2var(aig->inputs[enc.operand_input[i]].lit));
+        out.buffer.push_back('*');
+        put_var(enc,
+          aiger_lit2var(aig->inputs[enc.operand_input[n + j]].lit));
+        out.flush_if_full();
+      }
+  } else {
+    for (unsigned i = 0; i < 2 * n; i++) {
+      out.buffer += " + ";
+      if (i % n) out.buffer += powers[i % n] + "*";
+      put_var(enc, aiger_lit2var(aig->inputs[enc.operand_input[i]].lit));
+      out.flush_if_full();
+    }
+  }
+  out.buffer += ";\n";
+  out.flush_if_full();
+}
+/*------------------------------------------------------------------------*/
+/**
+    Returns the specification of 'aig', see 'poly_spec'
+*/
+static int aiger_specification(const aiger * aig) {
+  unsigned n = aig->num_inputs / 2;
+  if (!n || aig->num_inputs % 2) return POLY_SPEC_NONE;
+  int spec = poly_spec;
+  if (spec == POLY_SPEC_AUTO) {
+    if (aig->num_outputs == 2 * n) spec = POLY_SPEC_MULT;
+    else if (aig->num_outputs == n + 1) spec = POLY_SPEC_ADD;
+    else spec = POLY_SPEC_NONE;
+  }
+  if (spec == POLY_SPEC_MULT && aig->num_outputs != 2 * n)
+    return POLY_SPEC_NONE;
+  if (spec == POLY_SPEC_ADD && aig->num_outputs != n + 1)
+    return POLY_SPEC_NONE;
+  return spec;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Assigns the inputs of 'enc.aig' to the bits of the operands of width
+    'enc.operand_width'. Named inputs have to be named 'a<k>' and 'b<k>'
+    with every bit exactly once, in any order, unnamed inputs are assigned
+    by position, the first half to a and the second half to b.
+
+    @return false if the names do not fit two operands
+*/
+static bool assign_operands(poly_encoder & enc) {
+  const aiger * aig = enc.aig;
+  unsigned n = enc.operand_width, num_named = 0;
+  enc.operand_bit.resize(2 * n);
+  enc.operand_input.assign(2 * n, 2 * n);
+  for (unsigned i = 0; i < 2 * n; i++) {
+    const char * name = aig->inputs[i].name;
+    unsigned bit = i;
+    if (name) {
+      num_named++;
+      char operand, rest;
+      if (sscanf(name, "%c%u%c", &operand, &bit, &rest) != 2 ||
+          (operand != 'a' && operand != 'b') || bit >= n)
+        return false;
+      if (operand == 'b') bit += n;
+    }
+    if (enc.operand_input[bit] != 2 * n) return false;
+    enc.operand_bit[i] = bit;
+    enc.operand_input[bit] = i;
+  }
+  // mixing named and unnamed inputs is ambiguous
+  return !num_named || num_named == 2 * n;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Computes the decimal powers 2^0 to 2^(num-1)
+*/
+static void compute_powers(std::vector<std::string> & powers, unsigned num) {
+  mpz_t pow;
+  mpz_init_set_ui(pow, 1);
+  std::vector<char> digits;
+  while (powers.size() < num) {
+    digits.resize(mpz_sizeinbase(pow, 10) + 2);
+    mpz_get_str(digits.data(), 10, pow);
+    powers.emplace_back(digits.data());
+    mpz_mul_2exp(pow, pow, 1);
+  }
+  mpz_clear(pow);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Encodes 'aig' with the given writer
+*/
+static void encode_aiger(aiger * aig, buffered_writer & out) {
+  if (aig->num_latches)
+    die("polynomials need a combinational AIG, the AIG has %u latches",
+      aig->num_latches);
+
+  poly_encoder enc = { out, aig, {}, 0, {}, {}, {} };
+  int spec = aiger_specification(aig);
+  enc.operand_width = spec == POLY_SPEC_NONE ? 0 : aig->num_inputs / 2;
+  if (enc.operand_width && !assign_operands(enc)) {
+    spec = POLY_SPEC_NONE;
+    enc.operand_width = 0;
+  }
+  if (spec != POLY_SPEC_NONE) compute_powers(enc.powers, aig->num_outputs);
+
+  enc.input_idx.assign(aig->maxvar + 1, -1);
+  for (unsigned i = 0; i < aig->num_inputs; i++)
+    enc.input_idx[aiger_lit2var(aig->inputs[i].lit)] = i;
+
+  std::vector<term> terms;
+  for (unsigned i = 0; i < aig->num_ands; i++) {
+    const aiger_and * and_node = aig->ands + i;
+    terms.clear();
+    and_terms(and_node->rhs0, and_node->rhs1, terms);
+    put_polynomial(enc, [&]() { put_var(enc, aiger_lit2var(and_node->lhs)); },
+      terms);
+  }
+  for (unsigned i = 0; i < aig->num_outputs; i++) {
+    terms.clear();
+    literal_terms(aig->outputs[i].lit, terms);
+    put_polynomial(enc, [&]() { out.buffer.push_back('s'); out.put_int(i); },
+      terms);
+  }
+  if (spec != POLY_SPEC_NONE) put_specification(enc, spec);
+}
+/*------------------------------------------------------------------------*/
+
+void write_poly_to_buffer(aiger * aig, std::string & buffer) {
+  buffer.clear();
+  buffered_writer out = { buffer, 0, 0 };
+  encode_aiger(aig, out);
+}
+/*------------------------------------------------------------------------*/
+
+void write_fuzzed_poly(const char * output_name) {
+  FILE * output_file = open_output_file(output_name);
+
+  std::string buffer;
+  buffer.reserve(WRITER_BUFFER_SIZE + 64);
+  buffered_writer out = { buffer, output_file, output_name };
+  encode_aiger(model, out);
+  out.flush();
+  if (!close_output_file(output_file))
+    die("failed to write polynomials to '%s'", output_name);
+
+  msg("Output");
+  msg("==========================================================");
+  msg("  Printed fuzzed polynomials to: '%s'", output_name);
+  msg("");
+}
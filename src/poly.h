@@ -0,0 +1,57 @@
+/*------------------------------------------------------------------------*/
+/*! \file poly.h
+    \brief contains the encoding of the AIG as polynomials for algebraic
+    verification
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_POLY_H_
+#define AIGENFUZZER_SRC_POLY_H_
+/*------------------------------------------------------------------------*/
+#include <string>
+#include "parser.h"
+/*------------------------------------------------------------------------*/
+
+#define POLY_SPEC_AUTO 0   // /< derived from the number of inputs and outputs
+#define POLY_SPEC_MULT 1   // /< unsigned multiplier of two n-bit operands
+#define POLY_SPEC_ADD 2    // /< unsigned adder of two n-bit operands
+#define POLY_SPEC_NONE 3   // /< only the gate polynomials are written
+
+extern bool poly_output;   // /< mutants are written as polynomials
+extern int poly_spec;      // /< specification added to the polynomials
+
+/**
+    Encodes the combinational 'aig' as polynomials over the
+    integers in linear time, one per line terminated by ';'. Each AND gate
+    'x = AND(u,v)' gives the gate polynomial '-x + U*V', where U is 'u' or
+    '1-u' for a negated input, expanded and simplified, e.g. '-l5 + a0*b0'.
+    The gates are named 'l<var>' and written in topological order, followed
+    by '-s<i> + O' for each output. If the numbers of inputs and outputs
+    fit a multiplier (2n inputs, 2n outputs) or an adder (2n inputs, n+1
+    outputs), see 'poly_spec', the inputs are the operands a0..a(n-1) and
+    b0..b(n-1), and the last line is the specification of the original
+    circuit, i.e., '-S + A*B' or '-S + A + B', where S, A and B are the
+    weighted sums of the bits. The bits of named inputs are taken from
+    their names 'a<k>' and 'b<k>' in any order, unnamed inputs are the
+    first half a and the second half b. If the names do not fit, or the
+    numbers do not, the inputs are named 'i<k>' and no specification is
+    written. Mutants keep
+    the specification of their input, thus a correct checker rejects them
+    unless the mutation is equivalent.
+
+    @param aig aiger*, e.g. 'aiger* model'
+    @param buffer std::string, previous content is discarded
+*/
+void write_poly_to_buffer(aiger * aig, std::string & buffer);
+
+/**
+    Writes the polynomials of 'aiger* model' to the file 'output_name'
+    through a fixed-size buffer.
+
+    @param output_name name of the output file
+*/
+void write_fuzzed_poly(const char * output_name);
+
+#endif  // AIGENFUZZER_SRC_POLY_H_
@@ -0,0 +1,168 @@
+/*------------------------------------------------------------------------*/
+/*! \file ring.cpp
+    \brief contains the delivery of mutants through a shared-memory ring
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "ring.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <string>
+
+#include "../includes/agf_ring.h"
+#include "cnf.h"
+#include "dedup.h"
+#include "difftest.h"
+#include "poly.h"
+/*------------------------------------------------------------------------*/
+// Global Variables
+const char * ring_name = 0;
+unsigned ring_size = 64;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+#define RING_POLL_MS 100   // /< sleep between checks for SIGINT and SIGTERM
+
+static struct agf_ring * ring;   // /< header of the mapped ring
+static unsigned char * data;     // /< data area of the ring
+static size_t map_size;          // /< bytes of the mapping
+static std::string path;         // /< '/<ring_name>'
+
+/*------------------------------------------------------------------------*/
+/**
+    Creates and maps the shared memory object of the ring
+*/
+static void create_ring() {
+  path = ring_name[0] == '/' ? ring_name : std::string("/") + ring_name;
+  uint64_t size = (uint64_t) ring_size << 20;
+  map_size = AGF_RING_HEADER_SIZE + size;
+
+  // a stale ring of a stopped run is replaced
+  shm_unlink(path.c_str());
+  int fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0) die("can not create shared memory '%s': %s", path.c_str(),
+    strerror(errno));
+  if (ftruncate(fd, map_size))
+    die("can not resize shared memory '%s': %s", path.c_str(),
+      strerror(errno));
+  void * map = mmap(0, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    die("can not map shared memory '%s': %s", path.c_str(), strerror(errno));
+
+  ring = (struct agf_ring *) map;
+  data = (unsigned char *) map + AGF_RING_HEADER_SIZE;
+  ring->size = size;
+  // readers accept the ring once the magic is visible
+  __atomic_store_n(&ring->magic, AGF_RING_MAGIC, __ATOMIC_RELEASE);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Waits until the reader has released all but 'size - needed' bytes
+
+    @return false if interrupted by SIGINT or SIGTERM
+*/
+static bool wait_for_space(uint64_t needed) {
+  uint64_t head = ring->head;
+  for (;;) {
+    if (interrupt_signal) return false;
+    uint32_t seq = __atomic_load_n(&ring->tail_seq, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&ring->writer_waiting, 1, __ATOMIC_SEQ_CST);
+    uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_SEQ_CST);
+    if (ring->size - (head - tail) >= needed) return true;
+    agf_ring_futex_wait(&ring->tail_seq, seq, RING_POLL_MS);
+  }
+}
+/*------------------------------------------------------------------------*/
+/**
+    Makes the first 'bytes' bytes after 'head' visible to the reader
+*/
+static void publish(uint64_t bytes) {
+  __atomic_store_n(&ring->head, ring->head + bytes, __ATOMIC_RELEASE);
+  agf_ring_futex_wake(&ring->head_seq, &ring->reader_waiting);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Copies the mutant 'mutant' with the given seed into the ring
+
+    @return false if interrupted by SIGINT or SIGTERM
+*/
+static bool write_record(unsigned seed, const std::string & mutant) {
+  uint64_t size = agf_ring_record_size(mutant.size());
+  if (size > ring->size)
+    die("mutant %u of %zu bytes does not fit into the ring, "
+      "increase '--shm-size'", seed, mutant.size());
+
+  // records are contiguous, the rest of the buffer is skipped if needed
+  uint64_t offset = ring->head % ring->size;
+  if (ring->size - offset < size) {
+    if (!wait_for_space(ring->size - offset)) return false;
+    struct agf_ring_record * wrap = (struct agf_ring_record *) (data + offset);
+    wrap->bytes = 0;
+    wrap->seed = 0;
+    wrap->wrap = 1;
+    publish(ring->size - offset);
+    offset = 0;
+  }
+  if (!wait_for_space(size)) return false;
+  struct agf_ring_record * record = (struct agf_ring_record *) (data + offset);
+  record->bytes = mutant.size();
+  record->seed = seed;
+  record->wrap = 0;
+  memcpy(record + 1, mutant.data(), mutant.size());
+  publish(size);
+  return true;
+}
+/*------------------------------------------------------------------------*/
+
+unsigned run_ring(unsigned seed) {
+  assert(ring_name);
+  if (!ring_size) die("option '--shm-size' needs a positive number");
+  create_ring();
+  store_base_model();
+  uint64_t base_hash = hash_aiger(base_model);
+
+  msg("Shared-memory ring");
+  msg("==========================================================");
+  msg("  Shared memory:   '%s'", path.c_str());
+  msg("  Ring size:       %u MB", ring_size);
+  if (num_mutants) msg("  Mutants:         %u", num_mutants);
+  else msg("  Mutants:         unlimited");
+  msg("");
+
+  // SIGINT and SIGTERM stop the generation after the current mutant
+  catch_interrupts = true;
+
+  std::string mutant;
+  unsigned written = 0;
+  while (!interrupt_signal && (!num_mutants || written < num_mutants)) {
+    quiet = true;
+    generate_mutant(base_model, base_hash, seed + written);
+    quiet = false;
+    if (cnf_output) write_cnf_to_buffer(model, mutant);
+    else if (poly_output) write_poly_to_buffer(model, mutant);
+    else write_model_to_buffer(mutant);
+    if (!write_record(seed + written, mutant)) break;
+    written++;
+  }
+
+  __atomic_store_n(&ring->closed, 1, __ATOMIC_RELEASE);
+  agf_ring_futex_wake(&ring->head_seq, &ring->reader_waiting);
+  // the reader may still have to open the ring
+  wait_for_space(ring->size);
+  munmap(ring, map_size);
+  shm_unlink(path.c_str());
+
+  msg("Output");
+  msg("==========================================================");
+  msg("  Printed %u mutants to: '%s'", written, path.c_str());
+  if (interrupt_signal)
+    msg("  Stopped by:      %s", signal_name(interrupt_signal));
+  msg("");
+  return written;
+}
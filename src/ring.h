@@ -0,0 +1,35 @@
+/*------------------------------------------------------------------------*/
+/*! \file ring.h
+    \brief contains the delivery of mutants through a shared-memory ring
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_RING_H_
+#define AIGENFUZZER_SRC_RING_H_
+/*------------------------------------------------------------------------*/
+#include "fuzzer.h"
+/*------------------------------------------------------------------------*/
+
+extern const char * ring_name;   // /< shared memory object of '--shm', or 0
+extern unsigned ring_size;       // /< MB of the data area of the ring
+
+/**
+    Creates the POSIX shared memory object '/<ring_name>' holding a ring
+    buffer of 'ring_size' MB, and writes 'num_mutants' mutants of
+    'aiger* model' with the seeds 'seed', 'seed+1', ... into it, as AIG,
+    CNF or polynomials. A harness reads the mutants in place with the
+    functions of 'includes/agf_ring.h', which also describes the layout.
+    The generation waits while the ring is full, and at the end until the
+    reader has released all mutants, before the object is removed. If
+    'num_mutants' is 0, or the generation is stopped by SIGINT or SIGTERM,
+    mutants are written until the signal.
+
+    @param seed unsigned integer, seed of the first mutant
+
+    @return number of written mutants
+*/
+unsigned run_ring(unsigned seed);
+
+#endif  // AIGENFUZZER_SRC_RING_H_
@@ -0,0 +1,182 @@
+/*------------------------------------------------------------------------*/
+/*! \file scheduler.cpp
+    \brief contains the adaptive scheduling of the fuzzing operators
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "scheduler.h"
+
+#include <stdlib.h>
+
+#include "adder.h"
+#include "campaign.h"
+/*------------------------------------------------------------------------*/
+// Global Variables
+bool adaptive_scheduling = false;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+/**
+    Statistics of an operator, 'hits' and 'cost' are discounted
+*/
+struct scheduler_arm {
+  double hits;           // /< discounted number of interesting mutants
+  double cost;           // /< discounted CPU time of the tools
+  unsigned mutants;      // /< number of generated mutants
+  unsigned interesting;  // /< number of interesting mutants
+  double cpu_time;       // /< total CPU time of the tools
+};
+
+static scheduler_arm arms[NUM_OPERATORS + 1];   // /< indexed by operator
+
+static double total_hits, total_cost;   // /< discounted sums of all arms
+static double total_mutants;            // /< discounted number of mutants
+static bool base_adders;                // /< the input contains adders
+
+// share of the uniform distribution in the selection probability
+static const double exploration = 0.1;
+
+// weight of older results, applied on each update (half-life ~700 mutants)
+static const double discount = 0.999;
+
+// operators without results are assumed to have the average yield, as if
+// they were used for 'prior_mutants' mutants
+static const double prior_mutants = 10;
+
+/*------------------------------------------------------------------------*/
+
+void init_scheduler() {
+  for (int op = 0; op <= NUM_OPERATORS; op++) {
+    arms[op].hits = arms[op].cost = arms[op].cpu_time = 0;
+    arms[op].mutants = arms[op].interesting = 0;
+  }
+  total_hits = total_cost = total_mutants = 0;
+
+  std::vector<adder> adders;
+  find_adders(base_model, adders);
+  base_adders = !adders.empty();
+}
+/*------------------------------------------------------------------------*/
+/**
+    Returns true if the operator may be selected for the selected technique.
+    The latch operators are only selected for sequential models, the adder
+    operators only if the input contains adders.
+*/
+static bool is_enabled(int op) {
+  if (technique) return operator_technique(op) == technique;
+  if (operator_technique(op) == 7) return base_model->num_latches;
+  if (operator_technique(op) == 8) return base_adders;
+  return true;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Returns the estimated number of interesting mutants per CPU-second
+*/
+static double yield(int op) {
+  // the average cost of a mutant, 1 ms before the first result
+  double avg_cost = total_mutants ? total_cost / total_mutants : 0;
+  if (avg_cost <= 0) avg_cost = 1e-3;
+  double prior_cost = prior_mutants * avg_cost;
+  double avg_yield = (total_hits + 1) / (total_cost + prior_cost);
+  return (arms[op].hits + avg_yield * prior_cost) / (arms[op].cost + prior_cost);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Computes the selection probabilities of all operators
+*/
+static void compute_probabilities(double * prob) {
+  unsigned enabled = 0;
+  double sum = 0;
+  for (int op = 1; op <= NUM_OPERATORS; op++) {
+    prob[op] = is_enabled(op) ? yield(op) : 0;
+    if (is_enabled(op)) enabled++;
+    sum += prob[op];
+  }
+  assert(enabled);
+  for (int op = 1; op <= NUM_OPERATORS; op++) {
+    if (!is_enabled(op)) continue;
+    prob[op] = exploration / enabled + (1 - exploration) * prob[op] / sum;
+  }
+}
+/*------------------------------------------------------------------------*/
+
+int select_operator() {
+  double prob[NUM_OPERATORS + 1];
+  compute_probabilities(prob);
+
+  double r = (campaign_random() >> 11) * (1.0 / (1ull << 53));
+  int res = 0;
+  for (int op = 1; op <= NUM_OPERATORS; op++) {
+    if (!is_enabled(op)) continue;
+    res = op;
+    if (r < prob[op]) break;
+    r -= prob[op];
+  }
+  assert(res);
+  return res;
+}
+/*------------------------------------------------------------------------*/
+
+void update_scheduler(int op, double cpu_time, bool interesting) {
+  assert(op >= 1 && op <= NUM_OPERATORS);
+  total_hits = total_cost = 0;
+  for (int i = 1; i <= NUM_OPERATORS; i++) {
+    arms[i].hits *= discount;
+    arms[i].cost *= discount;
+  }
+
+  scheduler_arm & arm = arms[op];
+  arm.hits += interesting;
+  arm.cost += cpu_time;
+  arm.mutants++;
+  arm.interesting += interesting;
+  arm.cpu_time += cpu_time;
+  total_mutants = discount * total_mutants + 1;
+
+  for (int i = 1; i <= NUM_OPERATORS; i++) {
+    total_hits += arms[i].hits;
+    total_cost += arms[i].cost;
+  }
+}
+/*------------------------------------------------------------------------*/
+
+void print_scheduler_statistics() {
+  double prob[NUM_OPERATORS + 1];
+  compute_probabilities(prob);
+
+  msg("  operator          mutants  interesting  CPU time  per second  probability");
+  for (int op = 1; op <= NUM_OPERATORS; op++) {
+    const scheduler_arm & arm = arms[op];
+    msg("  %-16s %8u %12u %8.2f s %11.2f %11.1f%%", operator_name(op),
+      arm.mutants, arm.interesting, arm.cpu_time,
+      arm.cpu_time > 0 ? arm.interesting / arm.cpu_time : 0, 100 * prob[op]);
+  }
+}
+/*------------------------------------------------------------------------*/
+
+void save_scheduler(FILE * file) {
+  fprintf(file, "scheduler %.17g %.17g %.17g\n",
+    total_hits, total_cost, total_mutants);
+  for (int op = 1; op <= NUM_OPERATORS; op++) {
+    const scheduler_arm & arm = arms[op];
+    fprintf(file, "%.17g %.17g %u %u %.17g\n", arm.hits, arm.cost,
+      arm.mutants, arm.interesting, arm.cpu_time);
+  }
+}
+/*------------------------------------------------------------------------*/
+
+bool load_scheduler(FILE * file) {
+  if (fscanf(file, " scheduler %lg %lg %lg",
+      &total_hits, &total_cost, &total_mutants) != 3)
+    return false;
+  for (int op = 1; op <= NUM_OPERATORS; op++) {
+    scheduler_arm & arm = arms[op];
+    if (fscanf(file, "%lg %lg %u %u %lg", &arm.hits, &arm.cost,
+        &arm.mutants, &arm.interesting, &arm.cpu_time) != 5)
+      return false;
+  }
+  return true;
+}
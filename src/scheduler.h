@@ -0,0 +1,64 @@
+/*------------------------------------------------------------------------*/
+/*! \file scheduler.h
+    \brief contains the adaptive scheduling of the fuzzing operators
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_SCHEDULER_H_
+#define AIGENFUZZER_SRC_SCHEDULER_H_
+/*------------------------------------------------------------------------*/
+#include <stdio.h>
+#include "fuzzer.h"
+/*------------------------------------------------------------------------*/
+
+extern bool adaptive_scheduling;   // /< select operators by their yield
+
+/**
+    Initializes the statistics of all operators
+*/
+void init_scheduler();
+
+/**
+    Selects the operator for the next mutant. Each operator is selected with
+    a probability proportional to its yield, i.e., the number of interesting
+    mutants per CPU-second of the tools, mixed with a uniform distribution
+    to keep exploring. If 'technique' is set, only its operators are used.
+
+    @return operator between 1 and NUM_OPERATORS
+*/
+int select_operator();
+
+/**
+    Updates the yield of an operator after all tools terminated on a mutant.
+    Older results are discounted, thus the schedule follows the campaign.
+
+    @param op operator of the mutant
+    @param cpu_time CPU time of all tools on the mutant in seconds
+    @param interesting the mutant reached new coverage or a new maximum
+           cost, or is reported as crash, timeout or disagreement
+*/
+void update_scheduler(int op, double cpu_time, bool interesting);
+
+/**
+    Prints the statistics of all operators
+*/
+void print_scheduler_statistics();
+
+/**
+    Writes the statistics of all operators to a checkpoint
+
+    @param file checkpoint opened for writing
+*/
+void save_scheduler(FILE * file);
+
+/**
+    Restores the statistics of all operators from a checkpoint
+
+    @param file checkpoint opened for reading
+    @return false if the checkpoint is malformed
+*/
+bool load_scheduler(FILE * file);
+
+#endif  // AIGENFUZZER_SRC_SCHEDULER_H_
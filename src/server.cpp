@@ -0,0 +1,228 @@
+/*------------------------------------------------------------------------*/
+/*! \file server.cpp
+    \brief contains the mutant server answering requests on a Unix socket
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "server.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "cnf.h"
+#include "dedup.h"
+#include "poly.h"
+/*------------------------------------------------------------------------*/
+// Global Variables
+const char * server_socket = 0;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+#define MAX_REQUEST_SIZE 256   // /< longer lines close the connection
+
+/**
+    A connected client
+*/
+struct client {
+  int fd;                // /< non-blocking socket of the connection
+  std::string pending;   // /< received requests not answered yet
+  std::string output;    // /< answer not completely sent yet
+  size_t sent;           // /< bytes of 'output' already sent
+};
+
+static uint64_t base_hash;     // /< structural hash of 'aiger* base_model'
+static std::string answer;     // /< frame of the current answer
+static std::string encoding;   // /< encoded mutant of the current answer
+static unsigned long served;   // /< number of answered mutant requests
+
+/*------------------------------------------------------------------------*/
+/**
+    Sends as much of the pending answer of the client as its socket takes
+    without blocking
+
+    @return false if the client is gone
+*/
+static bool flush_client(client & c) {
+  while (c.sent < c.output.size()) {
+    // a closed connection is an error, not a SIGPIPE
+    ssize_t res = send(c.fd, c.output.data() + c.sent,
+      c.output.size() - c.sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (res < 0 && errno == EINTR) continue;
+    if (res < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+    if (res <= 0) return false;
+    c.sent += res;
+  }
+  c.output.clear();
+  c.sent = 0;
+  return true;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Generates the mutant of the request 'line' and writes the answer,
+    the frame of the mutant or an error line, to 'answer'
+*/
+static void answer_request(const std::string & line, int max_tech) {
+  unsigned long seed, tech = 0, mods = modifications;
+  char rest;
+  int fields = sscanf(line.c_str(), "%lu %lu %lu %c",
+    &seed, &tech, &mods, &rest);
+  if (fields < 1 || fields > 3 || seed > UINT_MAX) {
+    answer = "error expected '<seed> [<technique> [<modifications>]]'\n";
+    return;
+  }
+  if (tech > (unsigned long) max_tech) {
+    answer = "error technique needs to be between 0 and " +
+      std::to_string(max_tech) + "\n";
+    return;
+  }
+  if (mods > INT_MAX) {
+    answer = "error too many modifications\n";
+    return;
+  }
+
+  // the request overrides the options of the command line for one mutant
+  int saved_technique = technique;
+  int saved_operator = fuzz_operator;
+  int saved_modifications = modifications;
+  if (tech) {
+    technique = tech;
+    fuzz_operator = 0;
+  }
+  modifications = mods;
+  quiet = true;
+  generate_mutant(base_model, base_hash, seed);
+  quiet = false;
+  technique = saved_technique;
+  fuzz_operator = saved_operator;
+  modifications = saved_modifications;
+
+  if (cnf_output) write_cnf_to_buffer(model, encoding);
+  else if (poly_output) write_poly_to_buffer(model, encoding);
+  else write_model_to_buffer(encoding);
+  answer = std::to_string(seed) + " " + std::to_string(encoding.size()) + "\n";
+  answer += encoding;
+  served++;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Answers the complete requests of the client as long as its socket takes
+    the answers, the next request is only answered after the previous
+    answer is sent, which bounds the memory of clients not reading
+
+    @return false if the connection is closed
+*/
+static bool answer_requests(client & c, int max_tech) {
+  size_t start = 0, end;
+  while (c.output.empty() &&
+         (end = c.pending.find('\n', start)) != std::string::npos) {
+    answer_request(c.pending.substr(start, end - start), max_tech);
+    c.output.swap(answer);
+    start = end + 1;
+    if (!flush_client(c)) return false;
+  }
+  c.pending.erase(0, start);
+  return !c.output.empty() || c.pending.size() <= MAX_REQUEST_SIZE;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Receives requests from the client, which is only polled for input
+    while no answer is pending
+
+    @return false if the connection is closed
+*/
+static bool receive_requests(client & c) {
+  char buffer[4096];
+  ssize_t bytes = recv(c.fd, buffer, sizeof buffer, MSG_DONTWAIT);
+  if (bytes < 0 && (errno == EINTR || errno == EAGAIN ||
+      errno == EWOULDBLOCK))
+    return true;
+  if (bytes <= 0) return false;
+  c.pending.append(buffer, bytes);
+  return true;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Creates the listening socket at 'server_socket', replacing a stale one
+*/
+static int open_server_socket() {
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof addr);
+  addr.sun_family = AF_UNIX;
+  if (strlen(server_socket) >= sizeof addr.sun_path)
+    die("socket path '%s' is too long", server_socket);
+  strcpy(addr.sun_path, server_socket);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) die("can not create socket: %s", strerror(errno));
+  unlink(server_socket);
+  if (bind(fd, (struct sockaddr *) &addr, sizeof addr) ||
+      listen(fd, SOMAXCONN))
+    die("can not listen on '%s': %s", server_socket, strerror(errno));
+  return fd;
+}
+/*------------------------------------------------------------------------*/
+
+void run_server(int max_tech) {
+  assert(server_socket);
+  store_base_model();
+  base_hash = hash_aiger(base_model);
+  int listen_fd = open_server_socket();
+
+  msg("Mutant server");
+  msg("==========================================================");
+  msg("  Socket:          '%s'", server_socket);
+  msg("  Request:         '<seed> [<technique> [<modifications>]]'");
+  msg("");
+
+  // SIGINT and SIGTERM stop the server after the current request, no
+  // client blocks the server, as all sockets are non-blocking
+  catch_interrupts = true;
+
+  std::vector<client> clients;
+  std::vector<struct pollfd> fds;
+  while (!interrupt_signal) {
+    fds.assign(1, { listen_fd, POLLIN, 0 });
+    for (const client & c : clients) {
+      short events = c.output.empty() ? POLLIN : POLLOUT;
+      fds.push_back({ c.fd, events, 0 });
+    }
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR) continue;
+      die("polling the clients failed: %s", strerror(errno));
+    }
+
+    for (size_t i = clients.size(); i-- > 0; ) {
+      short revents = fds[i + 1].revents;
+      if (!revents) continue;
+      client & c = clients[i];
+      bool open = c.output.empty() ? receive_requests(c) : flush_client(c);
+      if (open && answer_requests(c, max_tech)) continue;
+      close(clients[i].fd);
+      clients.erase(clients.begin() + i);
+    }
+    if (fds[0].revents & POLLIN) {
+      int fd = accept4(listen_fd, 0, 0, SOCK_NONBLOCK);
+      if (fd >= 0) clients.push_back({ fd, std::string(), std::string(), 0 });
+    }
+  }
+
+  for (const client & c : clients) close(c.fd);
+  close(listen_fd);
+  unlink(server_socket);
+
+  msg("  Served mutants:  %lu", served);
+  msg("  Stopped by:      %s", signal_name(interrupt_signal));
+  msg("");
+}
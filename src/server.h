@@ -0,0 +1,34 @@
+/*------------------------------------------------------------------------*/
+/*! \file server.h
+    \brief contains the mutant server answering requests on a Unix socket
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_SERVER_H_
+#define AIGENFUZZER_SRC_SERVER_H_
+/*------------------------------------------------------------------------*/
+#include "fuzzer.h"
+/*------------------------------------------------------------------------*/
+
+extern const char * server_socket;   // /< path of the Unix socket, or 0
+
+/**
+    Keeps 'aiger* model' in memory and answers requests for its mutants on
+    the Unix domain socket 'server_socket' until SIGINT or SIGTERM. Each
+    request is a line '<seed> [<technique> [<modifications>]]', where
+    technique 0 and omitted values fall back to the command line options.
+    The answer is the frame '<seed> <bytes>' followed by the 'bytes' bytes
+    of the mutant as written by a single run with these options, i.e., AIG,
+    CNF or polynomials, or the line 'error <reason>'. A client may send
+    several requests on one connection, they are answered in order. The
+    sockets are non-blocking and the next request of a client is only read
+    once its previous answer is sent, thus a client that does not read its
+    answers neither blocks the other clients nor fills the memory.
+
+    @param max_tech largest valid technique
+*/
+void run_server(int max_tech);
+
+#endif  // AIGENFUZZER_SRC_SERVER_H_
@@ -9,12 +9,16 @@
 
 #include "signal_statistics.h"
 
+#include <time.h>
+
 /*------------------------------------------------------------------------*/
 // Global variable
 void(*original_SIGINT_handler)(int);
 void(*original_SIGSEGV_handler)(int);
 void(*original_SIGABRT_handler)(int);
 void(*original_SIGTERM_handler)(int);
+volatile sig_atomic_t interrupt_signal = 0;
+bool catch_interrupts = false;
 /*------------------------------------------------------------------------*/
 
 const char * signal_name(int sig) {
@@ -23,12 +27,24 @@ const char * signal_name(int sig) {
     case SIGSEGV: return "SIGSEGV";
     case SIGABRT: return "SIGABRT";
     case SIGTERM: return "SIGTERM";
+    case SIGBUS: return "SIGBUS";
+    case SIGFPE: return "SIGFPE";
+    case SIGILL: return "SIGILL";
+    case SIGKILL: return "SIGKILL";
+    case SIGXCPU: return "SIGXCPU";
     default: return "SIGUNKNOWN";
   }
 }
 
 /*------------------------------------------------------------------------*/
 static void catch_signal(int sig) {
+  // a campaign stops at the next tool run and writes a checkpoint,
+  // a second signal aborts
+  if (catch_interrupts && !interrupt_signal &&
+      (sig == SIGINT || sig == SIGTERM)) {
+    interrupt_signal = sig;
+    return;
+  }
   printf("c\nc caught signal '%s'(%d)\nc\n", signal_name(sig), sig);
   printf("c\nc raising signal '%s'(%d) again\n", signal_name(sig), sig);
   reset_all_signal_handlers();
@@ -59,14 +75,19 @@ void reset_all_signal_handlers() {
 
 /*------------------------------------------------------------------------*/
 
+bool quiet = false;
+bool messages_to_stderr = false;
+
 void msg(const char *fmt, ...) {
+  if (quiet) return;
+  FILE * file = messages_to_stderr ? stderr : stdout;
   va_list ap;
-  fputs_unlocked("[af] ", stdout);
+  fputs_unlocked("[af] ", file);
   va_start(ap, fmt);
-  vfprintf(stdout, fmt, ap);
+  vfprintf(file, fmt, ap);
   va_end(ap);
-  fputc_unlocked('\n', stdout);
-  fflush(stdout);
+  fputc_unlocked('\n', file);
+  fflush(file);
 }
 
 /*------------------------------------------------------------------------*/
@@ -108,6 +129,14 @@ double process_time() {
 
 /*------------------------------------------------------------------------*/
 
+double wall_clock_time() {
+  struct timespec ts;
+  if (clock_gettime(CLOCK_MONOTONIC, &ts)) return 0;
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+/*------------------------------------------------------------------------*/
+
 void print_statistics() {
   msg("");
   msg("Statistics");
@@ -30,6 +30,9 @@ extern void(*original_SIGTERM_handler)(int);
 */
 const char * signal_name(int sig);
 
+extern volatile sig_atomic_t interrupt_signal;  // /< caught SIGINT or SIGTERM
+extern bool catch_interrupts;   // /< record SIGINT and SIGTERM instead of aborting
+
 /**
     Initialize all signals
 */
@@ -49,11 +52,18 @@ void reset_all_signal_handlers();
 void die(const char *fmt, ...);
 
 /**
-    Prints a message to stdout
+    Prints a message to stdout, or to stderr if 'messages_to_stderr' is
+    set, unless messages are suppressed by 'quiet'
 
     @param char* fmt message
 */
 void msg(const char *fmt, ...);
+
+// / Suppresses msg(), used by modes that generate many mutants
+extern bool quiet;
+
+// / Prints msg() to stderr, used if stdout carries the output
+extern bool messages_to_stderr;
 /*------------------------------------------------------------------------*/
 
 // / Time measures used for verify/certify modus
@@ -70,6 +80,11 @@ size_t maximum_resident_set_size();
 */
 double process_time();
 
+/**
+    Determines the elapsed wall clock time from a monotonic clock
+*/
+double wall_clock_time();
+
 /**
     Print statistics of maximum memory and used process time depending on
     selected modus
@@ -0,0 +1,128 @@
+/*------------------------------------------------------------------------*/
+/*! \file split.cpp
+    \brief contains the splitting of the AIG into the cones of its outputs
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "split.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "executor.h"
+/*------------------------------------------------------------------------*/
+// Global Variables
+const char * split_dir = 0;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+#define CONES_PER_PASS 64   // /< outputs sharing one traversal
+
+static std::vector<uint64_t> cone_mask;   // /< outputs of the pass reading a var
+
+/*------------------------------------------------------------------------*/
+/**
+    Marks the cones of the outputs 'first' to 'first+CONES_PER_PASS-1' in
+    'cone_mask'. The AND gates of 'aiger* model' are ordered topologically,
+    thus a reverse pass propagates the masks of all outputs at once.
+*/
+static void mark_cones(unsigned first) {
+  cone_mask.assign(model->maxvar + 1, 0);
+  unsigned last = std::min(first + CONES_PER_PASS, model->num_outputs);
+  for (unsigned i = first; i < last; i++)
+    cone_mask[aiger_lit2var(model->outputs[i].lit)] |= 1ull << (i - first);
+
+  bool changed = true;
+  while (changed) {
+    for (unsigned i = model->num_ands; i-- > 0; ) {
+      const aiger_and * and_node = model->ands + i;
+      uint64_t mask = cone_mask[aiger_lit2var(and_node->lhs)];
+      if (!mask) continue;
+      cone_mask[aiger_lit2var(and_node->rhs0)] |= mask;
+      cone_mask[aiger_lit2var(and_node->rhs1)] |= mask;
+    }
+    // a latch in a cone adds its next state function to the cone
+    changed = false;
+    for (unsigned i = 0; i < model->num_latches; i++) {
+      const aiger_symbol * latch = model->latches + i;
+      uint64_t mask = cone_mask[aiger_lit2var(latch->lit)];
+      uint64_t & next = cone_mask[aiger_lit2var(latch->next)];
+      if ((next | mask) == next) continue;
+      next |= mask;
+      changed = true;
+    }
+  }
+}
+/*------------------------------------------------------------------------*/
+/**
+    Builds the AIG of the output 'idx', whose bit in 'cone_mask' is 'bit',
+    and writes it to 'split_dir'
+*/
+static void write_output_cone(unsigned idx, unsigned bit) {
+  uint64_t flag = 1ull << bit;
+  aiger * cone = aiger_init();
+  for (unsigned i = 0; i < model->num_inputs; i++)
+    aiger_add_input(cone, model->inputs[i].lit, model->inputs[i].name);
+  for (unsigned i = 0; i < model->num_latches; i++) {
+    const aiger_symbol * latch = model->latches + i;
+    if (!(cone_mask[aiger_lit2var(latch->lit)] & flag)) continue;
+    aiger_add_latch(cone, latch->lit, latch->next, latch->name);
+    aiger_add_reset(cone, latch->lit, latch->reset);
+  }
+  for (unsigned i = 0; i < model->num_ands; i++) {
+    const aiger_and * and_node = model->ands + i;
+    if (!(cone_mask[aiger_lit2var(and_node->lhs)] & flag)) continue;
+    aiger_add_and(cone, and_node->lhs, and_node->rhs0, and_node->rhs1);
+  }
+  aiger_add_output(cone, model->outputs[idx].lit, model->outputs[idx].name);
+
+  char path[4096];
+  snprintf(path, sizeof path, "%s/o%u.aig", split_dir, idx);
+  FILE * file = fopen(path, "w");
+  if (!file) die("can not write output cone to '%s'", path);
+  if (!aiger_write_to_file(cone, aiger_binary_mode, file))
+    die("failed to write output cone to '%s'", path);
+  fclose(file);
+  aiger_reset(cone);
+}
+/*------------------------------------------------------------------------*/
+
+unsigned write_output_cones() {
+  assert(split_dir);
+  make_directory(split_dir);
+  unsigned num_threads = max_jobs ? max_jobs : number_of_cores();
+
+  for (unsigned first = 0; first < model->num_outputs;
+      first += CONES_PER_PASS) {
+    mark_cones(first);
+
+    // the threads only read the model and the masks
+    unsigned last = std::min(first + CONES_PER_PASS, model->num_outputs);
+    std::atomic<unsigned> next(first);
+    auto worker = [&]() {
+      unsigned idx;
+      while ((idx = next++) < last) write_output_cone(idx, idx - first);
+    };
+    std::vector<std::thread> threads;
+    unsigned num = std::min(num_threads, last - first);
+    for (unsigned i = 1; i < num; i++) threads.emplace_back(worker);
+    worker();
+    for (std::thread & thread : threads) thread.join();
+  }
+  cone_mask.clear();
+  cone_mask.shrink_to_fit();
+
+  msg("Output cones");
+  msg("==========================================================");
+  msg("  Printed %u output cones to: '%s'", model->num_outputs, split_dir);
+  msg("");
+  return model->num_outputs;
+}
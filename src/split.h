@@ -0,0 +1,31 @@
+/*------------------------------------------------------------------------*/
+/*! \file split.h
+    \brief contains the splitting of the AIG into the cones of its outputs
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_SPLIT_H_
+#define AIGENFUZZER_SRC_SPLIT_H_
+/*------------------------------------------------------------------------*/
+#include "parser.h"
+/*------------------------------------------------------------------------*/
+
+extern const char * split_dir;   // /< directory of the output cones, or 0
+
+/**
+    Writes one AIG per output of 'aiger* model' to 'split_dir' as
+    'o<i>.aig', containing all inputs, the output and only the latches and
+    AND gates in its cone of influence. The cones of 64 outputs at a time
+    are computed in one shared reverse topological traversal, which marks
+    each variable with a bit mask of the outputs reading it, repeated
+    until the masks of the latches are propagated to their next state
+    functions. The files of these outputs are then built and written
+    concurrently by 'max_jobs' threads, default number of cores.
+
+    @return number of written files
+*/
+unsigned write_output_cones();
+
+#endif  // AIGENFUZZER_SRC_SPLIT_H_
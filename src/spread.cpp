@@ -0,0 +1,315 @@
+/*------------------------------------------------------------------------*/
+/*! \file spread.cpp
+    \brief contains the runtime spread test on equivalent variants of an AIG
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "spread.h"
+
+#include <stdio.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "dedup.h"
+#include "level.h"
+#include "target.h"
+#include "triage.h"
+/*------------------------------------------------------------------------*/
+// Global Variables
+unsigned num_variants = 10;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+/**
+    The base or an equivalent variant together with the results of all
+    tools on it
+*/
+struct variant {
+  unsigned seed;                      // /< seed of the variant
+  std::string path;                   // /< temporary file of the variant
+  std::string aig;                    // /< binary AIGER encoding
+  unsigned finished;                  // /< number of terminated tools
+  std::vector<double> times;          // /< CPU time per tool, -1 if missing
+  std::vector<std::string> verdicts;  // /< termination per tool
+};
+
+static std::vector<variant> variants;   // /< index 0 is the base
+
+// consecutive duplicates after which no further variants are generated
+static const unsigned max_duplicates = 1000;
+
+static FILE * log_file;
+static const char * log_input_name;
+
+static uint64_t base_hash;      // /< structural hash of the input
+static unsigned next_seed;      // /< seed of the next variant
+static unsigned duplicates, tool_runs;
+static bool exhausted;          // /< no further distinct variants found
+
+/*------------------------------------------------------------------------*/
+/**
+    Generates the next distinct variant, or the base if no variant exists
+    yet, and writes it to the temporary directory.
+
+    @return false if all variants are generated
+*/
+static bool add_next_variant() {
+  if (exhausted || variants.size() == num_variants + 1) return false;
+
+  variant var;
+  if (variants.empty()) {
+    load_model(base_model);
+    var.seed = 0;
+  } else {
+    unsigned attempts = 0;
+    do {
+      if (attempts++ == max_duplicates) {
+        exhausted = true;
+        return false;
+      }
+      var.seed = next_seed++;
+      generate_mutant(base_model, base_hash, var.seed);
+    } while (!insert_mutant_hash(model_hash) && ++duplicates);
+  }
+
+  var.finished = 0;
+  var.times.assign(tools.size(), -1);
+  var.verdicts.resize(tools.size());
+  write_model_to_buffer(var.aig);
+
+  // fork servers copy the variant to their own input file
+  if (!use_forkserver) {
+    char path[4096];
+    snprintf(path, sizeof path, "%s/agf-%d-spread-%zu.aig",
+      temporary_directory(), getpid(), variants.size());
+    var.path = path;
+    write_buffer_to_file(path, var.aig);
+  }
+  variants.push_back(var);
+  return true;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Stores the CPU time and the verdict of a terminated tool. The file of
+    a variant is removed once all tools terminated on it.
+*/
+static void handle_spread_run(const tool_run & run) {
+  variant & var = variants[run.job];
+  if (!run.timeout && !WIFSIGNALED(run.status) &&
+      WEXITSTATUS(run.status) == 127)
+    die("tool '%s' could not be executed", tools[run.tool_idx].command.c_str());
+
+  // fork servers do not provide the CPU time of their children
+  var.times[run.tool_idx] = run.forkserver >= 0 ? run.wall_time : run.cpu_time;
+  var.verdicts[run.tool_idx] = describe_tool_run(run);
+  if (!run.timeout && has_sanitizer_report(run.error_output))
+    var.verdicts[run.tool_idx] += " (sanitizer)";
+
+  if (++var.finished < tools.size()) return;
+  if (!var.path.empty()) unlink(var.path.c_str());
+  var.path.clear();
+  var.aig.clear();
+}
+/*------------------------------------------------------------------------*/
+/**
+    Appends the command line reproducing the variant to the log
+*/
+static void log_reproduce(unsigned seed) {
+  fprintf(log_file, "  reproduce: aigofuzzing %s out.aig -s %u -m %d",
+    log_input_name, seed, modifications);
+  if (fuzz_operator) fprintf(log_file, " -o %d", fuzz_operator);
+  else fprintf(log_file, " -t %d", technique);
+  if (target_metric)
+    fprintf(log_file, " --target %s", target_metric_name());
+  if (max_depth) fprintf(log_file, " --max-depth %u", max_depth);
+  if (strash_mutant) fprintf(log_file, " --strash");
+  if (prune_mutant) fprintf(log_file, " --coi");
+  fputc('\n', log_file);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Regenerates the variant with the given seed and stores it as 'name' in
+    the results directory.
+
+    @return path of the stored variant
+*/
+static std::string store_variant(unsigned seed, const std::string & name) {
+  std::string path = std::string(results_dir) + "/" + name;
+  std::string data;
+  quiet = true;
+  generate_mutant(base_model, base_hash, seed);
+  quiet = false;
+  write_model_to_buffer(data);
+  write_buffer_to_file(path.c_str(), data);
+  return path;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Reports the spread of the CPU time of a tool over the base and all
+    variants, and stores its fastest and slowest variant.
+*/
+static void report_spread(unsigned tool_idx) {
+  std::vector<std::pair<double, unsigned>> times;   // (time, variant)
+  for (unsigned i = 1; i < variants.size(); i++)
+    if (variants[i].times[tool_idx] >= 0)
+      times.push_back({variants[i].times[tool_idx], i});
+
+  msg("  tool %u '%s'", tool_idx, tools[tool_idx].command.c_str());
+  double base = variants.empty() ? -1 : variants[0].times[tool_idx];
+  if (base < 0 || times.empty()) {
+    msg("    no complete results");
+    return;
+  }
+  std::sort(times.begin(), times.end());
+
+  const variant & fastest = variants[times.front().second];
+  const variant & slowest = variants[times.back().second];
+  double median = times[times.size() / 2].first;
+  double min = std::min(base, times.front().first);
+  double max = std::max(base, times.back().first);
+  // times below a millisecond are not measured reliably
+  double spread = std::max(max, 1e-3) / std::max(min, 1e-3);
+
+  msg("    base:      %8.3f s", base);
+  msg("    variants:  %8.3f s min (seed %u), %.3f s median, "
+    "%.3f s max (seed %u)", times.front().first, fastest.seed, median,
+    times.back().first, slowest.seed);
+  msg("    spread:    %8.1fx", spread);
+
+  fprintf(log_file, "spread tool %u: base %.3f s, min %.3f s, median %.3f s, "
+    "max %.3f s, spread %.1fx, %s\n", tool_idx, base, times.front().first,
+    median, times.back().first, spread, tools[tool_idx].command.c_str());
+
+  char name[64];
+  snprintf(name, sizeof name, "spread-%u-fastest.aig", tool_idx);
+  std::string path = store_variant(fastest.seed, name);
+  fprintf(log_file, "fastest seed %u, %.3f s, file %s\n", fastest.seed,
+    times.front().first, path.c_str());
+  log_reproduce(fastest.seed);
+
+  snprintf(name, sizeof name, "spread-%u-slowest.aig", tool_idx);
+  path = store_variant(slowest.seed, name);
+  fprintf(log_file, "slowest seed %u, %.3f s, file %s\n", slowest.seed,
+    times.back().first, path.c_str());
+  log_reproduce(slowest.seed);
+}
+/*------------------------------------------------------------------------*/
+/**
+    Stores and logs the variants on which the verdict of a tool, other than
+    a timeout, differs from its verdict on the base
+
+    @return number of inconsistent variants
+*/
+static unsigned report_inconsistencies() {
+  unsigned res = 0;
+  if (variants.empty()) return res;
+  const variant & base = variants[0];
+
+  for (unsigned i = 1; i < variants.size(); i++) {
+    const variant & var = variants[i];
+    bool inconsistent = false;
+    for (unsigned t = 0; t < tools.size(); t++) {
+      if (var.verdicts[t].empty() || base.verdicts[t].empty()) continue;
+      if (var.verdicts[t] == "timeout" || base.verdicts[t] == "timeout")
+        continue;
+      if (var.verdicts[t] != base.verdicts[t]) inconsistent = true;
+    }
+    if (!inconsistent) continue;
+    res++;
+
+    char name[64];
+    snprintf(name, sizeof name, "inconsistent-%u.aig", var.seed);
+    std::string path = store_variant(var.seed, name);
+    fprintf(log_file, "inconsistent seed %u file %s\n", var.seed,
+      path.c_str());
+    log_reproduce(var.seed);
+    for (unsigned t = 0; t < tools.size(); t++)
+      fprintf(log_file, "  %-16s base %-16s %s\n", var.verdicts[t].c_str(),
+        base.verdicts[t].c_str(), tools[t].command.c_str());
+    msg("  inconsistent  seed %u", var.seed);
+  }
+  return res;
+}
+/*------------------------------------------------------------------------*/
+
+void run_spread_test(const char * input_name, unsigned seed) {
+  if (tools.empty()) die("no tool given for the spread test (try '-h')");
+
+  make_directory(results_dir);
+  char path[4096];
+  snprintf(path, sizeof path, "%s/results.log", results_dir);
+  if (!(log_file = fopen(path, "a"))) die("can not write log to '%s'", path);
+  log_input_name = input_name;
+
+  init_executor();
+  store_base_model();
+  base_hash = hash_aiger(base_model);
+  insert_mutant_hash(base_hash);
+  next_seed = seed;
+
+  msg("Spread test");
+  msg("==========================================================");
+  msg("  Tools:           %zu", tools.size());
+  for (const tool & t : tools) msg("                   '%s'", t.command.c_str());
+  msg("  Variants:        %u", num_variants);
+  msg("  Parallel jobs:   %u", max_jobs);
+  msg("  Temporary dir:   '%s'", temporary_directory());
+  msg("  Results dir:     '%s'", results_dir);
+  msg("");
+
+  double start = wall_clock_time();
+  catch_interrupts = true;
+
+  // the next tool run is tool 'next_tool' on variant 'current'
+  size_t current = 0;
+  unsigned next_tool = 0;
+  while (!interrupt_signal) {
+    bool available = current < variants.size();
+    if (!available && !executor_full()) {
+      quiet = true;
+      available = add_next_variant();
+      quiet = false;
+    }
+    if (available && !executor_full()) {
+      const variant & var = variants[current];
+      execute_tool(tools[next_tool], next_tool, var.path.c_str(), var.aig,
+        current);
+      tool_runs++;
+      if (++next_tool == tools.size()) { next_tool = 0; current++; }
+      continue;
+    }
+    tool_run run;
+    if (collect_tool_run(run, true)) handle_spread_run(run);
+    else if (!executor_running()) break;
+  }
+
+  double elapsed = wall_clock_time() - start;
+  catch_interrupts = false;
+  if (interrupt_signal)
+    msg("  caught signal '%s', stopping", signal_name(interrupt_signal));
+
+  reset_executor();
+  for (const variant & var : variants)
+    if (!var.path.empty()) unlink(var.path.c_str());
+
+  unsigned inconsistent = report_inconsistencies();
+
+  msg("");
+  for (unsigned t = 0; t < tools.size(); t++) report_spread(t);
+  fclose(log_file);
+
+  msg("");
+  msg("  variants:        %zu", variants.empty() ? 0 : variants.size() - 1);
+  msg("  duplicates:      %u", duplicates);
+  msg("  tool runs:       %u", tool_runs);
+  msg("  inconsistent:    %u", inconsistent);
+  msg("  wall clock time: %.2f seconds", elapsed);
+  msg("");
+
+  variants.clear();
+}
@@ -0,0 +1,33 @@
+/*------------------------------------------------------------------------*/
+/*! \file spread.h
+    \brief contains the runtime spread test on equivalent variants of an AIG
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_SPREAD_H_
+#define AIGENFUZZER_SRC_SPREAD_H_
+/*------------------------------------------------------------------------*/
+#include "difftest.h"
+/*------------------------------------------------------------------------*/
+
+extern unsigned num_variants;   // /< number of equivalent variants
+
+/**
+    Runs all tools on 'aiger* base_model' and on 'num_variants' equivalent
+    variants of it in a bounded process pool. The variants are generated
+    with the seeds 'seed', 'seed+1', ... using the equivalence-preserving
+    rewrites (technique 6), duplicates are skipped.
+
+    For each tool the spread of the CPU time over the base and the variants
+    is reported, and the fastest and slowest variants are stored in
+    'results_dir'. Variants on which the verdict of a tool differs from its
+    verdict on the base are stored as inconsistent.
+
+    @param input_name name of the input file, used for the log
+    @param seed unsigned integer, seed of the first variant
+*/
+void run_spread_test(const char * input_name, unsigned seed);
+
+#endif  // AIGENFUZZER_SRC_SPREAD_H_
@@ -0,0 +1,137 @@
+/*------------------------------------------------------------------------*/
+/*! \file strash.cpp
+    \brief contains the structural hashing of the fuzzed AIG
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "strash.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+static unsigned strash_constants;   // /< ANDs with a constant input
+static unsigned strash_trivial;     // /< ANDs of the form AND(x,x), AND(x,!x)
+static unsigned strash_duplicates;  // /< ANDs with an existing input pair
+
+/*------------------------------------------------------------------------*/
+/**
+    Returns the literal of the AND of 'a' and 'b' in 'strashed'. Simplifies
+    constant and trivial inputs and reuses an existing AND gate of the
+    normalized pair '(max, min)' if it is contained in 'table'.
+*/
+static unsigned strash_and(
+  aiger * strashed, std::unordered_map<uint64_t, unsigned> & table,
+  unsigned a, unsigned b) {
+  if (a < b) { unsigned tmp = a; a = b; b = tmp; }
+
+  if (b == aiger_false) { strash_constants++; return aiger_false; }
+  if (b == aiger_true)  { strash_constants++; return a; }
+  if (a == b)           { strash_trivial++;   return a; }
+  if (a == aiger_not(b)) { strash_trivial++;  return aiger_false; }
+
+  uint64_t key = (static_cast<uint64_t>(a) << 32) | b;
+  auto it = table.find(key);
+  if (it != table.end()) { strash_duplicates++; return it->second; }
+
+  unsigned lhs = aiger_var2lit(strashed->maxvar + 1);
+  aiger_add_and(strashed, lhs, a, b);
+  table.emplace(key, lhs);
+  return lhs;
+}
+/*------------------------------------------------------------------------*/
+
+unsigned strash_model() {
+  assert(model);
+  aiger_reencode(model);
+
+  strash_constants = strash_trivial = strash_duplicates = 0;
+
+  // after reencoding the ANDs are topologically sorted by their lhs
+  std::vector<unsigned> code(2*(model->maxvar + 1));
+  code[aiger_false] = aiger_false;
+  code[aiger_true] = aiger_true;
+
+  aiger * strashed = aiger_init();
+
+  for (unsigned i = 0; i < model->num_inputs; i++) {
+    aiger_symbol * input = model->inputs + i;
+    aiger_add_input(strashed, input->lit, input->name);
+    code[input->lit] = input->lit;
+    code[aiger_not(input->lit)] = aiger_not(input->lit);
+  }
+
+  for (unsigned i = 0; i < model->num_latches; i++) {
+    aiger_symbol * latch = model->latches + i;
+    code[latch->lit] = latch->lit;
+    code[aiger_not(latch->lit)] = aiger_not(latch->lit);
+  }
+
+  // latches are added with their next state functions later, hence
+  // reserve their indices before the first AND gate is created
+  if (model->num_latches)
+    strashed->maxvar = aiger_lit2var(model->latches[model->num_latches-1].lit);
+
+  std::unordered_map<uint64_t, unsigned> table;
+  table.reserve(model->num_ands);
+
+  for (unsigned i = 0; i < model->num_ands; i++) {
+    aiger_and * and_node = model->ands + i;
+    unsigned res = strash_and(strashed, table,
+      code[and_node->rhs0], code[and_node->rhs1]);
+    code[and_node->lhs] = res;
+    code[aiger_not(and_node->lhs)] = aiger_not(res);
+  }
+
+  for (unsigned i = 0; i < model->num_latches; i++) {
+    aiger_symbol * latch = model->latches + i;
+    aiger_add_latch(strashed, latch->lit, code[latch->next], latch->name);
+    aiger_add_reset(strashed, latch->lit, code[latch->reset]);
+  }
+
+  for (unsigned i = 0; i < model->num_outputs; i++) {
+    aiger_symbol * output = model->outputs + i;
+    aiger_add_output(strashed, code[output->lit], output->name);
+  }
+
+  for (unsigned i = 0; i < model->num_bad; i++)
+    aiger_add_bad(strashed, code[model->bad[i].lit], model->bad[i].name);
+  for (unsigned i = 0; i < model->num_constraints; i++)
+    aiger_add_constraint(strashed, code[model->constraints[i].lit],
+      model->constraints[i].name);
+  std::vector<unsigned> lits;
+  for (unsigned i = 0; i < model->num_justice; i++) {
+    const aiger_symbol * justice = model->justice + i;
+    lits.clear();
+    for (unsigned j = 0; j < justice->size; j++)
+      lits.push_back(code[justice->lits[j]]);
+    aiger_add_justice(strashed, justice->size, lits.data(), justice->name);
+  }
+  for (unsigned i = 0; i < model->num_fairness; i++)
+    aiger_add_fairness(strashed, code[model->fairness[i].lit],
+      model->fairness[i].name);
+
+  for (char ** p = model->comments; *p; p++) aiger_add_comment(strashed, *p);
+
+  unsigned removed = model->num_ands - strashed->num_ands;
+
+  aiger_reset(model);
+  model = strashed;
+  aiger_reencode(model);
+  update_model_miloa();
+
+  msg("Structural hashing");
+  msg("==========================================================");
+  msg("  constant inputs: %u", strash_constants);
+  msg("  trivial ANDs:    %u", strash_trivial);
+  msg("  duplicate ANDs:  %u", strash_duplicates);
+  msg("  removed %u AND gates", removed);
+  msg("  MILOA:           %u %u %u %u %u", M, I, L, O, A);
+  msg("");
+
+  return removed;
+}
@@ -0,0 +1,23 @@
+/*------------------------------------------------------------------------*/
+/*! \file strash.h
+    \brief contains the structural hashing of the fuzzed AIG
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_STRASH_H_
+#define AIGENFUZZER_SRC_STRASH_H_
+/*------------------------------------------------------------------------*/
+#include "parser.h"
+
+/**
+    Rebuilds 'aiger* model' using structural hashing. AND gates with a
+    constant input, trivial AND gates such as AND(x,x) and AND(x,!x), and
+    AND gates with the same normalized pair of inputs are merged.
+
+    @return number of removed AND gates
+*/
+unsigned strash_model();
+
+#endif  // AIGENFUZZER_SRC_STRASH_H_
@@ -0,0 +1,218 @@
+/*------------------------------------------------------------------------*/
+/*! \file target.cpp
+    \brief contains the weighted selection of the AND gates to modify
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "target.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "fuzzer.h"
+#include "level.h"
+/*------------------------------------------------------------------------*/
+// Global Variables
+int target_metric = TARGET_UNIFORM;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+static const char * metric_names[] = {
+  "uniform", "level", "fanout", "observability" };
+
+#define SIM_WORDS 4   // /< 64-bit words of random patterns for observability
+
+// Walker's alias table: AND gate 'i' is drawn with probability
+// (prob[i] + sum of (1-prob[j]) over all 'j' with alias[j] == i) / size
+static std::vector<double> prob;        // /< probability to keep a slot
+static std::vector<unsigned> alias;     // /< gate drawn otherwise
+
+static const aiger * table_source = 0;  // /< AIG the table is built for
+static uint64_t table_hash;             // /< structural hash of the source
+
+/*------------------------------------------------------------------------*/
+
+int parse_target_metric(const char * name) {
+  for (int i = TARGET_UNIFORM; i <= TARGET_OBSERVABILITY; i++)
+    if (!strcmp(name, metric_names[i])) return i;
+  return -1;
+}
+/*------------------------------------------------------------------------*/
+
+const char * target_metric_name() {
+  return metric_names[target_metric];
+}
+/*------------------------------------------------------------------------*/
+/**
+    Logic level of each AND gate, where inputs and latches have level 0
+*/
+static void level_weights(const aiger * aig, std::vector<double> & weights) {
+  std::vector<unsigned> levels;
+  compute_levels(aig, levels);
+  for (unsigned i = 0; i < aig->num_ands; i++)
+    weights[i] = levels[aiger_lit2var(aig->ands[i].lhs)];
+}
+/*------------------------------------------------------------------------*/
+/**
+    Number of AND gates, outputs and next state functions reading each AND
+    gate
+*/
+static void fanout_weights(const aiger * aig, std::vector<double> & weights) {
+  std::vector<unsigned> fanout(aig->maxvar + 1, 0);
+  for (unsigned i = 0; i < aig->num_ands; i++) {
+    fanout[aiger_lit2var(aig->ands[i].rhs0)]++;
+    fanout[aiger_lit2var(aig->ands[i].rhs1)]++;
+  }
+  for (unsigned i = 0; i < aig->num_outputs; i++)
+    fanout[aiger_lit2var(aig->outputs[i].lit)]++;
+  for (unsigned i = 0; i < aig->num_latches; i++)
+    fanout[aiger_lit2var(aig->latches[i].next)]++;
+
+  for (unsigned i = 0; i < aig->num_ands; i++)
+    weights[i] = fanout[aiger_lit2var(aig->ands[i].lhs)];
+}
+/*------------------------------------------------------------------------*/
+/**
+    Number of random patterns under which an AND gate is observable. The
+    gates are simulated forward on 64*SIM_WORDS patterns, then observability
+    is propagated backward from the outputs and next state functions: an
+    input of an AND gate is observable if the gate is observable and its
+    other input is true. Reconvergence is ignored, thus this is a linear
+    approximation of the observability.
+*/
+static void observability_weights(const aiger * aig,
+  std::vector<double> & weights) {
+  std::vector<uint64_t> value((aig->maxvar + 1) * SIM_WORDS, 0);
+  std::vector<uint64_t> observed((aig->maxvar + 1) * SIM_WORDS, 0);
+
+  // fixed patterns, such that the weights only depend on the AIG
+  uint64_t state = 0x9e3779b97f4a7c15ull;
+  auto next_pattern = [&state]() {
+    uint64_t x = (state += 0x9e3779b97f4a7c15ull);
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+  };
+  for (unsigned i = 0; i < aig->num_inputs; i++)
+    for (unsigned w = 0; w < SIM_WORDS; w++)
+      value[aiger_lit2var(aig->inputs[i].lit) * SIM_WORDS + w] = next_pattern();
+  for (unsigned i = 0; i < aig->num_latches; i++)
+    for (unsigned w = 0; w < SIM_WORDS; w++)
+      value[aiger_lit2var(aig->latches[i].lit) * SIM_WORDS + w] =
+        next_pattern();
+
+  auto lit_value = [&value](unsigned lit, unsigned w) {
+    uint64_t res = value[aiger_lit2var(lit) * SIM_WORDS + w];
+    return aiger_sign(lit) ? ~res : res;
+  };
+  for (unsigned i = 0; i < aig->num_ands; i++) {
+    const aiger_and * and_node = aig->ands + i;
+    for (unsigned w = 0; w < SIM_WORDS; w++)
+      value[aiger_lit2var(and_node->lhs) * SIM_WORDS + w] =
+        lit_value(and_node->rhs0, w) & lit_value(and_node->rhs1, w);
+  }
+
+  for (unsigned i = 0; i < aig->num_outputs; i++)
+    for (unsigned w = 0; w < SIM_WORDS; w++)
+      observed[aiger_lit2var(aig->outputs[i].lit) * SIM_WORDS + w] = ~0ull;
+  for (unsigned i = 0; i < aig->num_latches; i++)
+    for (unsigned w = 0; w < SIM_WORDS; w++)
+      observed[aiger_lit2var(aig->latches[i].next) * SIM_WORDS + w] = ~0ull;
+
+  for (unsigned i = aig->num_ands; i-- > 0; ) {
+    const aiger_and * and_node = aig->ands + i;
+    unsigned lhs = aiger_lit2var(and_node->lhs);
+    unsigned rhs0 = aiger_lit2var(and_node->rhs0);
+    unsigned rhs1 = aiger_lit2var(and_node->rhs1);
+    unsigned count = 0;
+    for (unsigned w = 0; w < SIM_WORDS; w++) {
+      uint64_t obs = observed[lhs * SIM_WORDS + w];
+      observed[rhs0 * SIM_WORDS + w] |= obs & lit_value(and_node->rhs1, w);
+      observed[rhs1 * SIM_WORDS + w] |= obs & lit_value(and_node->rhs0, w);
+      count += __builtin_popcountll(obs);
+    }
+    weights[i] = count;
+  }
+}
+/*------------------------------------------------------------------------*/
+/**
+    Builds the alias table for the weights with Vose's method. If all
+    weights are zero, every AND gate is equally likely.
+*/
+static void build_alias_table(std::vector<double> & weights) {
+  size_t size = weights.size();
+  prob.assign(size, 1);
+  alias.resize(size);
+  for (size_t i = 0; i < size; i++) alias[i] = i;
+
+  double sum = 0;
+  for (double weight : weights) sum += weight;
+  if (sum <= 0) return;
+
+  std::vector<unsigned> small, large;
+  for (size_t i = 0; i < size; i++) {
+    weights[i] *= size / sum;
+    if (weights[i] < 1) small.push_back(i);
+    else large.push_back(i);
+  }
+  while (!small.empty() && !large.empty()) {
+    unsigned s = small.back(), l = large.back();
+    small.pop_back();
+    prob[s] = weights[s];
+    alias[s] = l;
+    weights[l] -= 1 - weights[s];
+    if (weights[l] < 1) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // the remaining slots are full up to rounding errors
+  for (unsigned i : small) prob[i] = 1;
+  for (unsigned i : large) prob[i] = 1;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Builds the alias table of the AND gates of 'aig'
+*/
+static void build_target_table(const aiger * aig) {
+  std::vector<double> weights(aig->num_ands, 1);
+  switch (target_metric) {
+    case TARGET_LEVEL:
+      level_weights(aig, weights);
+      break;
+    case TARGET_FANOUT:
+      fanout_weights(aig, weights);
+      break;
+    case TARGET_OBSERVABILITY:
+      observability_weights(aig, weights);
+      break;
+  }
+  build_alias_table(weights);
+}
+/*------------------------------------------------------------------------*/
+
+void prepare_target_table(const aiger * aig, uint64_t hash) {
+  if (aig == table_source && hash == table_hash &&
+      prob.size() == aig->num_ands) return;
+  build_target_table(aig);
+  table_source = aig;
+  table_hash = hash;
+}
+/*------------------------------------------------------------------------*/
+
+unsigned choose_target_and() {
+  assert(A);
+  if (prob.size() != A) {
+    // the model is no copy of a prepared AIG anymore
+    build_target_table(model);
+    table_source = 0;
+  }
+  unsigned res = rangeRandomZeroMax(A);
+  if (rand() / (RAND_MAX + 1.0) >= prob[res]) res = alias[res];
+  return res;
+}
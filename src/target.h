@@ -0,0 +1,56 @@
+/*------------------------------------------------------------------------*/
+/*! \file target.h
+    \brief contains the weighted selection of the AND gates to modify
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_TARGET_H_
+#define AIGENFUZZER_SRC_TARGET_H_
+/*------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "parser.h"
+/*------------------------------------------------------------------------*/
+
+#define TARGET_UNIFORM 0         // /< every AND gate is equally likely
+#define TARGET_LEVEL 1           // /< weighted by the logic level
+#define TARGET_FANOUT 2          // /< weighted by the number of fanouts
+#define TARGET_OBSERVABILITY 3   // /< weighted by simulated observability
+
+extern int target_metric;        // /< weight of the AND gates to modify
+
+/**
+    Returns the metric with the given name, or -1 if there is none
+
+    @param name 'uniform', 'level', 'fanout' or 'observability'
+*/
+int parse_target_metric(const char * name);
+
+/**
+    Returns the name of 'target_metric'
+*/
+const char * target_metric_name();
+
+/**
+    Builds the alias table of the AND gates of 'aig' for 'target_metric'
+    in linear time, unless it is already built for 'aig' with the given
+    structural hash. The table is used for 'aiger* model' after 'aig' has
+    been copied into it.
+
+    @param aig aiger*, e.g. 'aiger* base_model'
+    @param hash structural hash of 'aig', see 'hash_aiger'
+*/
+void prepare_target_table(const aiger * aig, uint64_t hash);
+
+/**
+    Draws an AND gate of 'aiger* model' in constant time with a probability
+    proportional to its weight. If the number of AND gates of the model
+    differs from the table, e.g. after a constant is inserted, the table is
+    rebuilt for the model first.
+
+    @return index of the AND gate in 'model->ands'
+*/
+unsigned choose_target_and();
+
+#endif  // AIGENFUZZER_SRC_TARGET_H_
@@ -0,0 +1,270 @@
+/*------------------------------------------------------------------------*/
+/*! \file triage.cpp
+    \brief contains the bucketing of failing mutants by fingerprints
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#include "triage.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+
+#include "parser.h"
+/*------------------------------------------------------------------------*/
+// Global Variables
+std::vector<failure_bucket> buckets;
+
+/*------------------------------------------------------------------------*/
+// Local Variables
+
+static std::unordered_map<uint64_t, unsigned> bucket_index;   // /< by hash
+
+#define MAX_FRAMES 3          // /< sanitizer frames in a fingerprint
+#define MAX_LINE_LENGTH 120   // /< length of a normalized stderr line
+
+/*------------------------------------------------------------------------*/
+/**
+    64-bit FNV-1a hash of a string
+*/
+static uint64_t hash_string(const std::string & str) {
+  uint64_t res = 14695981039346656037ull;
+  for (unsigned char c : str) {
+    res ^= c;
+    res *= 1099511628211ull;
+  }
+  return res;
+}
+/*------------------------------------------------------------------------*/
+
+bool has_sanitizer_report(const std::string & error_output) {
+  return error_output.find("ERROR: AddressSanitizer") != std::string::npos ||
+    error_output.find("ERROR: LeakSanitizer") != std::string::npos ||
+    error_output.find("WARNING: MemorySanitizer") != std::string::npos ||
+    error_output.find("WARNING: ThreadSanitizer") != std::string::npos ||
+    error_output.find("runtime error: ") != std::string::npos;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Returns true if the function of a stack frame belongs to a sanitizer
+    runtime or the C library, which is the same for all reports.
+*/
+static bool is_runtime_frame(const std::string & function) {
+  static const char * prefixes[] = {
+    "__asan", "__lsan", "__msan", "__tsan", "__ubsan", "__sanitizer",
+    "__interceptor", "___interceptor", "__GI_", "raise", "abort",
+    "__libc_", "__assert", "__pthread_kill" };
+  for (const char * prefix : prefixes)
+    if (!function.compare(0, strlen(prefix), prefix)) return true;
+  return false;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Replaces numbers and hexadecimal addresses by '#' and collapses white
+    space, such that messages only differing in values, addresses or
+    process ids match.
+*/
+static std::string normalize_line(const std::string & line) {
+  std::string res;
+  for (size_t i = 0; i < line.size() && res.size() < MAX_LINE_LENGTH; ) {
+    unsigned char c = line[i];
+    if (isdigit(c)) {
+      if (c == '0' && i + 1 < line.size() && line[i+1] == 'x') i += 2;
+      while (i < line.size() && isxdigit(static_cast<unsigned char>(line[i])))
+        i++;
+      res += '#';
+    } else if (isspace(c)) {
+      while (i < line.size() && isspace(static_cast<unsigned char>(line[i])))
+        i++;
+      if (!res.empty()) res += ' ';
+    } else {
+      res += c;
+      i++;
+    }
+  }
+  while (!res.empty() && res.back() == ' ') res.pop_back();
+  return res;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Extracts the error type and the top frames outside of the runtime of a
+    sanitizer report, e.g. "heap-buffer-overflow in parse < main".
+
+    @return empty string if stderr contains no stack trace
+*/
+static std::string sanitizer_signature(const std::string & error_output) {
+  std::istringstream stream(error_output);
+  std::string line, type, frames;
+  unsigned num_frames = 0;
+  bool in_trace = false;
+
+  while (std::getline(stream, line)) {
+    size_t pos;
+    if (type.empty() && (pos = line.find("Sanitizer: ")) != std::string::npos) {
+      std::istringstream words(line.substr(pos + 11));
+      words >> type;
+    } else if (type.empty() &&
+               (pos = line.find("runtime error: ")) != std::string::npos) {
+      type = normalize_line(line.substr(pos + 15));
+    }
+
+    // frames look like "    #0 0x4f5a1b in function file.c:12:3"
+    std::istringstream words(line);
+    std::string number, address, in, function;
+    if (!(words >> number >> address >> in >> function) ||
+        number[0] != '#' || in != "in") {
+      // only the first stack trace of a report is used
+      if (in_trace) break;
+      continue;
+    }
+    in_trace = true;
+    if (is_runtime_frame(function)) continue;
+    if (num_frames++ == MAX_FRAMES) break;
+    if (!frames.empty()) frames += " < ";
+    frames += function;
+  }
+  if (frames.empty()) return type;
+  return type + " in " + frames;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Returns the first non-empty normalized line of stderr
+*/
+static std::string first_stderr_line(const std::string & error_output) {
+  std::istringstream stream(error_output);
+  std::string line;
+  while (std::getline(stream, line)) {
+    std::string res = normalize_line(line);
+    if (!res.empty()) return res;
+  }
+  return "";
+}
+/*------------------------------------------------------------------------*/
+
+std::string fingerprint_tool_run(const char * kind, unsigned tool_idx,
+  const tool_run & run) {
+  std::string res = "tool " + std::to_string(tool_idx) + " " + kind;
+
+  if (!strcmp(kind, "timeout")) return res;
+
+  if (WIFSIGNALED(run.status))
+    res += std::string(" ") + signal_name(WTERMSIG(run.status));
+  else
+    res += " exit " + std::to_string(WEXITSTATUS(run.status));
+
+  std::string details = sanitizer_signature(run.error_output);
+  if (details.empty()) details = first_stderr_line(run.error_output);
+  if (!details.empty()) res += ": " + details;
+  return res;
+}
+/*------------------------------------------------------------------------*/
+
+unsigned add_to_bucket(const char * kind, const std::string & signature,
+  unsigned seed, unsigned ands, size_t size, bool & replaced) {
+  uint64_t hash = hash_string(std::string(kind) + "\n" + signature);
+  auto it = bucket_index.find(hash);
+
+  if (it == bucket_index.end()) {
+    failure_bucket bucket;
+    bucket.hash = hash;
+    bucket.kind = kind;
+    bucket.signature = signature;
+    bucket.count = 1;
+    bucket.seed = seed;
+    bucket.ands = ands;
+    bucket.size = size;
+    bucket_index[hash] = buckets.size();
+    buckets.push_back(bucket);
+    replaced = true;
+    return buckets.size() - 1;
+  }
+
+  failure_bucket & bucket = buckets[it->second];
+  bucket.count++;
+  replaced = ands < bucket.ands || (ands == bucket.ands && size < bucket.size);
+  if (replaced) {
+    bucket.seed = seed;
+    bucket.ands = ands;
+    bucket.size = size;
+  }
+  return it->second;
+}
+/*------------------------------------------------------------------------*/
+/**
+    Returns the buckets sorted by decreasing count
+*/
+static std::vector<const failure_bucket*> sorted_buckets() {
+  std::vector<const failure_bucket*> res;
+  for (const failure_bucket & bucket : buckets) res.push_back(&bucket);
+  std::stable_sort(res.begin(), res.end(),
+    [](const failure_bucket * a, const failure_bucket * b) {
+      return a->count > b->count; });
+  return res;
+}
+/*------------------------------------------------------------------------*/
+
+void write_buckets(const char * dir) {
+  std::string path = std::string(dir) + "/buckets.txt";
+  FILE * file = fopen(path.c_str(), "w");
+  if (!file) die("can not write buckets to '%s'", path.c_str());
+
+  for (const failure_bucket * bucket : sorted_buckets()) {
+    fprintf(file, "%-12s %8u  %016llx  seed %u, %u ands, %s\n",
+      bucket->kind.c_str(), bucket->count,
+      static_cast<unsigned long long>(bucket->hash), bucket->seed,
+      bucket->ands, bucket->path.c_str());
+    fprintf(file, "  %s\n", bucket->signature.c_str());
+  }
+  fclose(file);
+}
+/*------------------------------------------------------------------------*/
+
+void print_buckets() {
+  for (const failure_bucket * bucket : sorted_buckets())
+    msg("  %-12s %8u  %s", bucket->kind.c_str(), bucket->count,
+      bucket->signature.c_str());
+}
+/*------------------------------------------------------------------------*/
+
+void save_buckets(FILE * file) {
+  fprintf(file, "buckets %zu\n", buckets.size());
+  for (const failure_bucket & bucket : buckets) {
+    fprintf(file, "%016llx %s %u %u %u %zu\n",
+      static_cast<unsigned long long>(bucket.hash), bucket.kind.c_str(),
+      bucket.count, bucket.seed, bucket.ands, bucket.size);
+    fprintf(file, "%s\n%s\n", bucket.path.c_str(), bucket.signature.c_str());
+  }
+}
+/*------------------------------------------------------------------------*/
+
+bool load_buckets(FILE * file) {
+  size_t size;
+  std::string line;
+  if (fscanf(file, " buckets %zu", &size) != 1 || !read_line(file, line))
+    return false;
+
+  buckets.clear();
+  bucket_index.clear();
+  for (size_t i = 0; i < size; i++) {
+    failure_bucket bucket;
+    unsigned long long hash;
+    char kind[32];
+    if (fscanf(file, "%llx %31s %u %u %u %zu", &hash, kind, &bucket.count,
+        &bucket.seed, &bucket.ands, &bucket.size) != 6 ||
+        !read_line(file, line) ||
+        !read_line(file, bucket.path) || !read_line(file, bucket.signature))
+      return false;
+    bucket.hash = hash;
+    bucket.kind = kind;
+    bucket_index[bucket.hash] = buckets.size();
+    buckets.push_back(bucket);
+  }
+  return true;
+}
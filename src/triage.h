@@ -0,0 +1,94 @@
+/*------------------------------------------------------------------------*/
+/*! \file triage.h
+    \brief contains the bucketing of failing mutants by fingerprints
+
+  Part of AIGoFuzzing : Mutation-Based AIG Fuzzer
+  Copyright(C) 2022 Daniela Kaufmann, Johannes Kepler University Linz
+*/
+/*------------------------------------------------------------------------*/
+#ifndef AIGENFUZZER_SRC_TRIAGE_H_
+#define AIGENFUZZER_SRC_TRIAGE_H_
+/*------------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "executor.h"
+/*------------------------------------------------------------------------*/
+
+/**
+    Failures with the same fingerprint, represented by the smallest mutant
+*/
+struct failure_bucket {
+  uint64_t hash;            // /< hash of the signature
+  std::string kind;         // /< "crash", "timeout" or "disagreement"
+  std::string signature;    // /< readable fingerprint of the failure
+  std::string path;         // /< file of the representative
+  unsigned count;           // /< number of failing mutants
+  unsigned seed;            // /< seed of the representative
+  unsigned ands;            // /< AND gates of the representative
+  size_t size;              // /< size in bytes of the representative
+};
+
+extern std::vector<failure_bucket> buckets;   // /< in order of discovery
+
+/**
+    Returns true if the stderr of a tool contains a sanitizer report
+*/
+bool has_sanitizer_report(const std::string & error_output);
+
+/**
+    Computes the readable fingerprint of a failing tool run, consisting of
+    the index of the tool, the signal, the error type and the top three
+    frames of a sanitizer report, or otherwise the normalized first line of
+    stderr, in which numbers and addresses are removed.
+
+    @param kind "crash" or "timeout"
+    @param tool_idx index of the tool
+    @param run tool_run
+*/
+std::string fingerprint_tool_run(const char * kind, unsigned tool_idx,
+  const tool_run & run);
+
+/**
+    Adds a failing mutant to the bucket of its signature. The representative
+    of a bucket is only replaced if the mutant has fewer AND gates, or the
+    same number of AND gates but fewer bytes.
+
+    @param kind "crash", "timeout" or "disagreement"
+    @param signature readable fingerprint of the failure
+    @param seed seed of the mutant
+    @param ands number of AND gates of the mutant
+    @param size size in bytes of the mutant
+    @param replaced set to true if the mutant is the new representative
+    @return index of the bucket
+*/
+unsigned add_to_bucket(const char * kind, const std::string & signature,
+  unsigned seed, unsigned ands, size_t size, bool & replaced);
+
+/**
+    Writes the buckets sorted by count to 'buckets.txt' in 'dir'
+*/
+void write_buckets(const char * dir);
+
+/**
+    Prints the buckets sorted by count
+*/
+void print_buckets();
+
+/**
+    Writes the buckets to a checkpoint
+
+    @param file checkpoint opened for writing
+*/
+void save_buckets(FILE * file);
+
+/**
+    Restores the buckets from a checkpoint
+
+    @param file checkpoint opened for reading
+    @return false if the checkpoint is malformed
+*/
+bool load_buckets(FILE * file);
+
+#endif  // AIGENFUZZER_SRC_TRIAGE_H_